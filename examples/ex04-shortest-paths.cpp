@@ -1,4 +1,4 @@
-// example of the use of the all_shortest_paths algorithm (Dijkstra's algorithm)
+// example of the use of the shortest paths algorithms (Dijkstra's, A* and bidirectional A* algorithms)
 // it's try to find the shortest path between two stations in the London Tube network
 
 // the main issue is that there is only one edge/line between two vertices/stations
@@ -23,6 +23,7 @@ class Program {
 
   void run_dijkstra() const;
   void run_a_star() const;
+  void run_bidirectional_a_star() const;
 
  private:
   void print_path(generator<g::Step<lt::Station, double>>& path) const;
@@ -103,6 +104,26 @@ void Program::run_a_star() const {
   }
 }
 
+void Program::run_bidirectional_a_star() const {
+  print_frame("Bidirectional A* algorithm");
+
+  // the distance as the crow flies never exceeds the distance along the tracks (consistent cost function)
+  auto cost_function = [](const lt::Station& a, const lt::Station& b) -> double {
+    return a.distance_from(b);
+  };
+
+  for (const auto& dest : _destinations) {
+    std::println("===> {} to {}", _start._name, dest._name);
+    auto path = g::bidirectional_shortest_path(_tube, _start, dest, cost_function);
+    if (!path.is_reachable()) {
+      std::println(stderr, "Cannot find a path to {}", dest._name);
+    } else {
+      auto g = path.get_path();
+      print_path(g);
+    }
+  }
+}
+
 void Program::print_path(generator<g::Step<lt::Station, double>>& path) const {
   int prev_line = -1;
   g::vertex_t prev_station_id = _start._id;
@@ -143,5 +164,7 @@ int main(int argc, const char* argv[]) {
   program.run_dijkstra();
   std::println();
   program.run_a_star();
+  std::println();
+  program.run_bidirectional_a_star();
   return 0;
 }
@@ -11,7 +11,6 @@
 #include <grafology/algorithms/cycles.h>
 #include <cmath>
 #include <print>
-#include <set>
 
 // threshold = 0.01 %
 constexpr double threshold = 1.0001;
@@ -21,7 +20,6 @@ using weight_t = double;
 using vertex_t = g::vertex_t;
 using Graph = g::DenseGraphImpl<weight_t>;
 using Cycle = std::vector<vertex_t>;
-using CycleId = std::set<vertex_t>;
 
 
 int main() {
@@ -41,29 +39,21 @@ int main() {
 
     // vector of profit -> cycle
     std::vector<std::tuple<double, Cycle>> cycles;
-    // avoid duplicates
-    std::set<CycleId> found;
 
-    for (auto ccy_source = 0; ccy_source < n_ccys; ++ccy_source) {
-        for (auto cycle : g::find_all_negative_cycles(graph, ccy_source)) {
-            // already seen ?
-            CycleId cycle_id(cycle.begin(), cycle.end());
-            if (!found.insert(std::move(cycle_id)).second) {
-                continue;
-            }
-            // now compute the profit
-            double final_rate = 1;
-            int n = cycle.size();
-            for (int idx = 0; idx < n -1; ++idx) {
-                auto u = cycle[idx];
-                auto v = cycle[idx+1];
-                final_rate *= rates[u][v];
-            }
-            if (final_rate < threshold) {
-                continue;
-            }
-            cycles.push_back({(final_rate-1) * 100, cycle});
+    // the cycles are distinct, so no need to remove duplicates
+    for (auto cycle : g::find_negative_cycles(graph)) {
+        // now compute the profit
+        double final_rate = 1;
+        int n = cycle.size();
+        for (int idx = 0; idx < n -1; ++idx) {
+            auto u = cycle[idx];
+            auto v = cycle[idx+1];
+            final_rate *= rates[u][v];
+        }
+        if (final_rate < threshold) {
+            continue;
         }
+        cycles.push_back({(final_rate-1) * 100, cycle});
     }
     // let sort them by decreasing profit
     std::sort(cycles.begin(), cycles.end(), std::greater<>());
@@ -0,0 +1,638 @@
+#pragma once
+#include "../graph.h"
+#include "../indexed_heap.h"
+#include "all_shortest_paths.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <barrier>
+#include <limits>
+#include <queue>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace grafology {
+    //==============================================================================
+    // Implementation Graphs
+    //==============================================================================
+
+    /**
+     * @brief This struct allows to process the results of the all pairs shortest paths algorithms
+     * @details The distances are stored in a row-major matrix (like DenseGraphImpl). For the Floyd-Warshall
+     * algorithm, the rows are padded to a multiple of its tile size.
+     * The next hops (the vertex following i on the shortest path from i to j) are only stored
+     * if they have been requested.
+     */
+    template <typename weight_t>
+    struct AllPairsShortestPathsImpl {
+        static constexpr auto D_INFINITY = edge_t<weight_t>::D_INFINITY;
+        using step_lt = std::tuple<vertex_t, weight_t>;
+
+        AllPairsShortestPathsImpl(std::size_t n_vertices, std::size_t stride, bool with_next_hops)
+            : _n_vertices(n_vertices)
+            , _stride(stride)
+            , _distances(n_vertices * stride, D_INFINITY)
+            , _next_hops(with_next_hops ? n_vertices * stride : 0, NO_PREDECESSOR) {
+            for (vertex_t i = 0; i < n_vertices; ++i) {
+                _distances[i * _stride + i] = 0;
+                if (with_next_hops) {
+                    _next_hops[i * _stride + i] = i;
+                }
+            }
+        }
+
+        std::size_t size() const { return _n_vertices; }
+
+        bool has_next_hops() const { return !_next_hops.empty(); }
+
+        weight_t get_distance(vertex_t start, vertex_t end) const {
+            assert(start < _n_vertices && end < _n_vertices);
+            return _distances[start * _stride + end];
+        }
+
+        bool is_reachable(vertex_t start, vertex_t end) const { return get_distance(start, end) != D_INFINITY; }
+
+        /** @brief the distances from a vertex to all the vertices */
+        std::span<const weight_t> get_row(vertex_t start) const {
+            assert(start < _n_vertices);
+            return {_distances.data() + start * _stride, _n_vertices};
+        }
+
+        /** @brief the vertex following start on the shortest path to end (NO_PREDECESSOR if unreachable) */
+        vertex_t get_next_hop(vertex_t start, vertex_t end) const {
+            assert(has_next_hops());
+            assert(start < _n_vertices && end < _n_vertices);
+            return _next_hops[start * _stride + end];
+        }
+
+        /**
+         * @brief the shortest path from start to end with the distance from start of each step
+         * @throw error if the next hops have not been computed
+         */
+        std::vector<step_lt> get_path(vertex_t start, vertex_t end) const {
+            if (!has_next_hops()) {
+                throw error("All pairs shortest paths: the next hops have not been computed");
+            }
+            std::vector<step_lt> path;
+            if (!is_reachable(start, end)) {
+                return path;
+            }
+            path.push_back(std::make_tuple(start, 0));
+            for (auto current = start; current != end;) {
+                current = get_next_hop(current, end);
+                path.push_back(std::make_tuple(current, get_distance(start, current)));
+            }
+            return path;
+        }
+
+        std::size_t _n_vertices;
+        // the length of the rows
+        std::size_t _stride;
+        std::vector<weight_t> _distances;
+        std::vector<vertex_t> _next_hops;
+    };
+
+    namespace internal {
+        /**
+         * @brief The blocked Floyd-Warshall algorithm
+         * @details The matrix is split in tiles of TILE x TILE, which fit in the L1/L2 caches. For each
+         * diagonal tile kb:
+         * - phase 1: the tile (kb, kb) is closed with the classical algorithm
+         * - phase 2: the tiles of the row kb and of the column kb are updated from the diagonal tile
+         * - phase 3: all the other tiles (i, j) are updated from the tiles (i, kb) and (kb, j)
+         *
+         * The tiles of the phases 2 and 3 are independent, so they are shared between the threads,
+         * which are synchronised between the phases. The inner loop is a min-plus on a row of a tile
+         * simple enough to be vectorised by the compiler: the rows of k are copied in local buffers, so
+         * the compiler knows they don't overlap the updated row.
+         */
+        template <typename weight_t, bool WITH_NEXT_HOPS>
+        class FloydWarshall {
+           public:
+            static constexpr std::size_t TILE = 64;
+
+            /**
+             * @brief the infinite distance during the computation
+             * @remark for the integral types, it is half the maximum so that two distances can be added
+             * without overflow, and a sum with an infinite distance is kept infinite
+             */
+            static constexpr weight_t INF = std::numeric_limits<weight_t>::has_infinity
+                                                ? std::numeric_limits<weight_t>::infinity()
+                                                : std::numeric_limits<weight_t>::max() / 2;
+
+            FloydWarshall(AllPairsShortestPathsImpl<weight_t>& res)
+                : _d(res._distances.data())
+                , _next(res._next_hops.data())
+                , _stride(res._stride)
+                , _n_tiles(res._stride / TILE) {}
+
+            /** @brief close the tile (kb, kb). Return false if a negative cycle is found */
+            bool close_diagonal(std::size_t kb) {
+                auto c = tile(kb, kb);
+                std::array<weight_t, TILE> row_k;
+                for (std::size_t k = 0; k < TILE; ++k) {
+                    // NB: without negative cycle, the row k doesn't change during the step k
+                    std::copy_n(c + k * _stride, TILE, row_k.data());
+                    relax_rows(c, c, row_k.data(), k);
+                    if (c[k * _stride + k] < 0) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            /** @brief update the tile (kb, jb) of the row kb or (jb, kb) of the column kb */
+            void update_cross(std::size_t kb, std::size_t jb, bool is_row) {
+                auto diagonal = tile(kb, kb);
+                auto c = is_row ? tile(kb, jb) : tile(jb, kb);
+                std::array<weight_t, TILE> row_k;
+                for (std::size_t k = 0; k < TILE; ++k) {
+                    if (is_row) {
+                        std::copy_n(c + k * _stride, TILE, row_k.data());
+                        relax_rows(c, diagonal, row_k.data(), k);
+                    } else {
+                        std::copy_n(diagonal + k * _stride, TILE, row_k.data());
+                        relax_rows(c, c, row_k.data(), k);
+                    }
+                }
+            }
+
+            /** @brief update the tile (ib, jb) from the tiles (ib, kb) and (kb, jb) */
+            void update_tile(std::size_t kb, std::size_t ib, std::size_t jb) {
+                auto c = tile(ib, jb);
+                auto a = tile(ib, kb);
+                auto b = tile(kb, jb);
+                std::array<weight_t, TILE * TILE> b_copy;
+                for (std::size_t k = 0; k < TILE; ++k) {
+                    std::copy_n(b + k * _stride, TILE, b_copy.data() + k * TILE);
+                }
+                // the tiles are distinct: the rows can be processed in any order, each one in a local buffer
+                std::array<weight_t, TILE> c_i;
+                std::array<vertex_t, WITH_NEXT_HOPS ? TILE : 0> next_i;
+                for (std::size_t i = 0; i < TILE; ++i) {
+                    std::copy_n(c + i * _stride, TILE, c_i.data());
+                    if constexpr (WITH_NEXT_HOPS) {
+                        std::copy_n(next_hops(c) + i * _stride, TILE, next_i.data());
+                    }
+                    for (std::size_t k = 0; k < TILE; ++k) {
+                        const auto a_ik = a[i * _stride + k];
+                        if (a_ik != INF) {
+                            min_plus(c_i.data(), next_i.data(), b_copy.data() + k * TILE, a_ik, next_hop(a, i, k));
+                        }
+                    }
+                    std::copy_n(c_i.data(), TILE, c + i * _stride);
+                    if constexpr (WITH_NEXT_HOPS) {
+                        std::copy_n(next_i.data(), TILE, next_hops(c) + i * _stride);
+                    }
+                }
+            }
+
+            /**
+             * @brief run the algorithm with n_threads threads
+             * @return false if a negative cycle is found
+             */
+            bool run(unsigned n_threads) {
+                const auto n_tiles = _n_tiles;
+                std::atomic<bool> has_negative_cycle = false;
+                auto worker = [&](unsigned t, auto sync) {
+                    for (std::size_t kb = 0; kb < n_tiles; ++kb) {
+                        if (t == 0 && !close_diagonal(kb)) {
+                            has_negative_cycle = true;
+                        }
+                        sync();
+                        if (has_negative_cycle) {
+                            return;
+                        }
+                        for (std::size_t idx = t; idx < 2 * n_tiles; idx += n_threads) {
+                            if (idx / 2 != kb) {
+                                update_cross(kb, idx / 2, idx % 2 == 0);
+                            }
+                        }
+                        sync();
+                        for (std::size_t idx = t; idx < n_tiles * n_tiles; idx += n_threads) {
+                            auto ib = idx / n_tiles;
+                            auto jb = idx % n_tiles;
+                            if (ib != kb && jb != kb) {
+                                update_tile(kb, ib, jb);
+                            }
+                        }
+                        sync();
+                    }
+                };
+
+                if (n_threads <= 1) {
+                    worker(0, [] {});
+                } else {
+                    // the barrier must outlive the threads (which are joined in the vector destructor)
+                    std::barrier barrier(n_threads);
+                    auto sync = [&barrier] { barrier.arrive_and_wait(); };
+                    std::vector<std::jthread> threads;
+                    threads.reserve(n_threads - 1);
+                    for (unsigned t = 1; t < n_threads; ++t) {
+                        threads.emplace_back([&worker, &sync, t] { worker(t, sync); });
+                    }
+                    worker(0, sync);
+                }
+                return !has_negative_cycle;
+            }
+
+           private:
+            weight_t* tile(std::size_t ib, std::size_t jb) const { return _d + ib * TILE * _stride + jb * TILE; }
+
+            /** @brief the next hops of a tile, at the same offset as its distances */
+            vertex_t* next_hops(const weight_t* t) const { return _next + (t - _d); }
+
+            /** @brief relax all the rows of c through the column k of a and the row k (b_k) */
+            void relax_rows(weight_t* c, const weight_t* a, const weight_t* b_k, std::size_t k) {
+                for (std::size_t i = 0; i < TILE; ++i) {
+                    relax_row(c, a, b_k, i, k);
+                }
+            }
+
+            /** @brief the next hop of (i, k) in the tile t (if they are computed) */
+            vertex_t next_hop(const weight_t* t, std::size_t i, std::size_t k) const {
+                if constexpr (WITH_NEXT_HOPS) {
+                    return next_hops(t)[i * _stride + k];
+                } else {
+                    return NO_PREDECESSOR;
+                }
+            }
+
+            /** @brief c[i][j] = min(c[i][j], a[i][k] + b_k[j]) for all j */
+            void relax_row(weight_t* c, const weight_t* a, const weight_t* b_k, std::size_t i, std::size_t k) {
+                const auto a_ik = a[i * _stride + k];
+                if (a_ik == INF) {
+                    return;
+                }
+                // NB: the next hop of (i, k) is read before the row is updated
+                auto next_i = WITH_NEXT_HOPS ? next_hops(c) + i * _stride : nullptr;
+                min_plus(c + i * _stride, next_i, b_k, a_ik, next_hop(a, i, k));
+            }
+
+            /**
+             * @brief c[j] = min(c[j], a_ik + b_k[j]) for all j, and next[j] = next_ik for the improved distances
+             * @remark GCC only vectorises the updates of the next hops at -O2 if the buffers are local
+             * and with these forms of the selection (which differ for the integral and floating point types)
+             */
+            static void min_plus(weight_t* c, vertex_t* next, const weight_t* b_k, weight_t a_ik, vertex_t next_ik) {
+                if constexpr (!WITH_NEXT_HOPS) {
+                    for (std::size_t j = 0; j < TILE; ++j) {
+                        c[j] = std::min(c[j], add(a_ik, b_k[j]));
+                    }
+                } else if constexpr (std::numeric_limits<weight_t>::has_infinity) {
+                    for (std::size_t j = 0; j < TILE; ++j) {
+                        auto candidate = a_ik + b_k[j];
+                        auto current = c[j];
+                        c[j] = std::min(candidate, current);
+                        next[j] = candidate < current ? next_ik : next[j];
+                    }
+                } else {
+                    for (std::size_t j = 0; j < TILE; ++j) {
+                        auto candidate = add(a_ik, b_k[j]);
+                        auto current = c[j];
+                        c[j] = candidate < current ? candidate : current;
+                        next[j] = candidate < current ? next_ik : next[j];
+                    }
+                }
+            }
+
+            static weight_t add(weight_t finite, weight_t other) {
+                if constexpr (std::numeric_limits<weight_t>::has_infinity) {
+                    return finite + other;
+                } else {
+                    return other == INF ? INF : finite + other;
+                }
+            }
+
+            weight_t* _d;
+            vertex_t* _next;
+            std::size_t _stride;
+            std::size_t _n_tiles;
+        };
+    } // namespace internal
+
+    /**
+     * @brief Compute the shortest paths between all the pairs of vertices
+     * @remark this is based on the Floyd-Warshall algorithm, blocked in tiles which fit in the caches and
+     * processed by several threads (see internal::FloydWarshall). Negative weights are allowed.
+     * @remark For integral weights, the distances must be lower than half the maximum of the type.
+     * @param with_next_hops if true, the next hops are kept for getting the paths (get_path)
+     * @param n_threads the number of threads (0 for the hardware concurrency)
+     * @throw std::runtime_error if the graph has a negative cycle
+     */
+    template <typename G>
+        requires GraphImpl<G, typename G::weight_lt>
+    AllPairsShortestPathsImpl<typename G::weight_lt> all_pairs_shortest_paths_FW(
+        const G& graph,
+        bool with_next_hops = false,
+        unsigned n_threads = 0
+    ) {
+        using weight_lt = typename G::weight_lt;
+        static constexpr auto TILE = internal::FloydWarshall<weight_lt, false>::TILE;
+        static constexpr auto INF = internal::FloydWarshall<weight_lt, false>::INF;
+
+        const auto n_vertices = graph.size();
+        const auto stride = (n_vertices + TILE - 1) / TILE * TILE;
+        AllPairsShortestPathsImpl<weight_lt> res(n_vertices, stride, with_next_hops);
+        // NB: the padding (rows and columns) is infinite, so it never shortens a path
+        std::ranges::fill(res._distances, INF);
+        res._distances.resize(stride * stride, INF);
+        if (with_next_hops) {
+            res._next_hops.resize(stride * stride, NO_PREDECESSOR);
+        }
+        for (vertex_t i = 0; i < n_vertices; ++i) {
+            res._distances[i * stride + i] = std::min<weight_lt>(0, graph.weight(i, i));
+            if (with_next_hops) {
+                res._next_hops[i * stride + i] = i;
+            }
+            for_each_neighbor(graph, i, [&](const auto& edge) {
+                res._distances[i * stride + edge.end] = edge.weight;
+                if (with_next_hops) {
+                    res._next_hops[i * stride + edge.end] = edge.end;
+                }
+            });
+        }
+
+        if (n_threads == 0) {
+            n_threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        // there are at most (n_tiles - 1)^2 independent tiles
+        n_threads = std::max<std::size_t>(1, std::min<std::size_t>(n_threads, (stride / TILE - 1) * (stride / TILE - 1)));
+        bool is_valid = with_next_hops ? internal::FloydWarshall<weight_lt, true>(res).run(n_threads)
+                                       : internal::FloydWarshall<weight_lt, false>(res).run(n_threads);
+        if (!is_valid) {
+            throw std::runtime_error("Negative cycle detected");
+        }
+
+        // the padding rows are dropped and the infinite distances are restored
+        res._distances.resize(n_vertices * stride);
+        if (with_next_hops) {
+            res._next_hops.resize(n_vertices * stride);
+        }
+        if constexpr (INF != AllPairsShortestPathsImpl<weight_lt>::D_INFINITY) {
+            std::ranges::replace(res._distances, INF, AllPairsShortestPathsImpl<weight_lt>::D_INFINITY);
+        }
+        return res;
+    }
+
+    namespace internal {
+        /**
+         * @brief the potentials of the vertices for the Johnson's algorithm
+         * @details they are the distances from a virtual source linked to all the vertices with a null
+         * weight, computed with the queue-based Bellman-Ford algorithm (see all_shortest_paths_SPFA).
+         * For each edge (u, v), weight + potentials[u] - potentials[v] >= 0.
+         * @throw std::runtime_error if the graph has a negative cycle
+         */
+        template <typename G>
+        std::vector<typename G::weight_lt> johnson_potentials(const G& graph) {
+            using weight_lt = typename G::weight_lt;
+
+            const auto n_vertices = graph.size();
+            std::vector<weight_lt> potentials(n_vertices, 0);
+            // the number of edges of the path found for each vertex (without the virtual one)
+            std::vector<vertex_t> path_lengths(n_vertices, 0);
+            std::vector<bool> is_queued(n_vertices, true);
+            std::queue<vertex_t> queue;
+            for (vertex_t v = 0; v < n_vertices; ++v) {
+                // for_each_neighbor() skips the self loops
+                if (graph.weight(v, v) < 0) {
+                    throw std::runtime_error("Negative cycle detected");
+                }
+                queue.push(v);
+            }
+            while (!queue.empty()) {
+                auto v = queue.front();
+                queue.pop();
+                is_queued[v] = false;
+                for_each_neighbor(graph, v, [&](const auto& edge) {
+                    auto new_d = potentials[v] + edge.weight;
+                    if (new_d < potentials[edge.end]) {
+                        path_lengths[edge.end] = path_lengths[v] + 1;
+                        if (path_lengths[edge.end] >= n_vertices) {
+                            throw std::runtime_error("Negative cycle detected");
+                        }
+                        potentials[edge.end] = new_d;
+                        if (!is_queued[edge.end]) {
+                            queue.push(edge.end);
+                            is_queued[edge.end] = true;
+                        }
+                    }
+                });
+            }
+            return potentials;
+        }
+
+        /**
+         * @brief The edges of a graph reweighted by the potentials, in the CSR format
+         * @details the weights are reweighted once for all the sources, and the edges of each vertex are
+         * contiguous, which is faster to traverse than the original graph for the n runs of the Dijkstra's algorithm
+         */
+        template <typename weight_t>
+        struct ReweightedGraph {
+            using weight_lt = weight_t;
+
+            template <typename G>
+            ReweightedGraph(const G& graph, const std::vector<weight_t>& potentials)
+                : potentials(potentials)
+                , offsets(graph.size() + 1, 0) {
+                for (vertex_t v = 0; v < graph.size(); ++v) {
+                    for_each_neighbor(graph, v, [&](const auto& edge) {
+                        auto weight = edge.weight + potentials[v] - potentials[edge.end];
+                        if constexpr (std::is_floating_point_v<weight_t>) {
+                            // the rounding errors must not give negative weights
+                            weight = std::max<weight_t>(weight, 0);
+                        }
+                        ends.push_back(edge.end);
+                        weights.push_back(weight);
+                    });
+                    offsets[v + 1] = ends.size();
+                }
+            }
+
+            std::size_t size() const { return potentials.size(); }
+
+            const std::vector<weight_t>& potentials;
+            std::vector<std::size_t> offsets;
+            std::vector<vertex_t> ends;
+            std::vector<weight_t> weights;
+        };
+
+        /** @brief the neighbors of a vertex in the reweighted graph (found by DijkstraSearch) */
+        template <typename weight_t, typename F>
+        void for_each_neighbor(const ReweightedGraph<weight_t>& graph, vertex_t vertex, F&& f) {
+            for (auto e = graph.offsets[vertex]; e < graph.offsets[vertex + 1]; ++e) {
+                f(edge_t<weight_t>{.start = vertex, .end = graph.ends[e], .weight = graph.weights[e]});
+            }
+        }
+
+        /** @brief The Dijkstra's algorithm on the reweighted graph, whose distances are restored */
+        template <typename weight_t>
+        class JohnsonSearch : public DijkstraSearch<ReweightedGraph<weight_t>> {
+           public:
+            JohnsonSearch(const ReweightedGraph<weight_t>& graph)
+                : DijkstraSearch<ReweightedGraph<weight_t>>(graph) {}
+
+            /** @brief compute the shortest paths from start, with the original weights */
+            const AllShortestPathsImpl<weight_t>& run(vertex_t start) {
+                DijkstraSearch<ReweightedGraph<weight_t>>::run(start);
+                const auto& potentials = this->_graph.potentials;
+                for (auto v : this->_settled) {
+                    this->_res._distances[v] += potentials[v] - potentials[start];
+                }
+                return this->_res;
+            }
+        };
+
+        /** @brief call f(search, source) for each vertex, with a JohnsonSearch per thread */
+        template <typename G, typename F>
+        void johnson_for_each_source(const G& graph, F&& f, unsigned n_threads) {
+            const auto potentials = johnson_potentials(graph);
+            const ReweightedGraph<typename G::weight_lt> reweighted(graph, potentials);
+            for_each_source(
+                std::views::iota(vertex_t{0}, static_cast<vertex_t>(graph.size())),
+                [&reweighted] { return JohnsonSearch(reweighted); },
+                f,
+                n_threads
+            );
+        }
+    } // namespace internal
+
+    /**
+     * @brief Compute the shortest paths between all the pairs of vertices
+     * @remark this is based on the Johnson's algorithm: the weights are made non-negative once with
+     * potentials computed by the Bellman-Ford algorithm, then the Dijkstra's algorithm is run from each
+     * vertex, the sources being shared between the threads. Negative weights are allowed.
+     * On sparse graphs, it is faster than the Floyd-Warshall algorithm (O(n m log n) against O(n^3)).
+     * @remark the distances are stored in a n x n matrix: for large graphs, see the overload with a callback
+     * @param with_next_hops if true, the next hops are kept for getting the paths (get_path)
+     * @param n_threads the number of threads (0 for the hardware concurrency)
+     * @throw std::runtime_error if the graph has a negative cycle
+     */
+    template <typename G>
+        requires GraphImpl<G, typename G::weight_lt>
+    AllPairsShortestPathsImpl<typename G::weight_lt> all_pairs_shortest_paths_johnson(
+        const G& graph,
+        bool with_next_hops = false,
+        unsigned n_threads = 0
+    ) {
+        const auto n_vertices = graph.size();
+        AllPairsShortestPathsImpl<typename G::weight_lt> res(n_vertices, n_vertices, with_next_hops);
+        // each thread writes its own rows
+        auto store = [&](auto& search, vertex_t start) {
+            const auto& paths = search.run(start);
+            auto distances = res._distances.data() + start * n_vertices;
+            auto next_hops = res._next_hops.data() + start * n_vertices;
+            for (auto v : search.settled()) {
+                distances[v] = paths._distances[v];
+                if (with_next_hops && v != start) {
+                    // the predecessor of v is settled before v, so its next hop is known
+                    auto predecessor = paths._predecessors[v];
+                    next_hops[v] = predecessor == start ? v : next_hops[predecessor];
+                }
+            }
+        };
+        internal::johnson_for_each_source(graph, store, n_threads);
+        return res;
+    }
+
+    /**
+     * @brief Compute the shortest paths between all the pairs of vertices, and pass them source by source to f
+     * @details f(source, paths) is called for each vertex, with the shortest paths from this source
+     * (AllShortestPathsImpl). The memory is bounded by a workspace of O(n) per thread, so that the
+     * shortest paths of graphs too large for a n x n matrix can be processed.
+     * @remark f is called concurrently by the threads, and paths is only valid during the call
+     * @see all_pairs_shortest_paths_johnson(const G&, bool, unsigned)
+     * @throw std::runtime_error if the graph has a negative cycle, or the first exception thrown by f
+     */
+    template <typename G, typename F>
+        requires GraphImpl<G, typename G::weight_lt>
+              && std::invocable<F&, vertex_t, const AllShortestPathsImpl<typename G::weight_lt>&>
+    void all_pairs_shortest_paths_johnson(const G& graph, F&& f, unsigned n_threads = 0) {
+        internal::johnson_for_each_source(
+            graph,
+            [&f](auto& search, vertex_t start) { f(start, search.run(start)); },
+            n_threads
+        );
+    }
+
+    //==============================================================================
+    // Graphs
+    //==============================================================================
+
+    /**
+     * @brief The shortest paths between all the pairs of vertices of a graph
+     */
+    template <typename Impl, VertexKey Vertex, bool IsDirected>
+        requires GraphImpl<Impl, typename Impl::weight_lt>
+    struct AllPairsShortestPaths {
+        using weight_lt = typename Impl::weight_lt;
+        using step_lt = Step<Vertex, weight_lt>;
+        static constexpr auto D_INFINITY = edge_t<weight_lt>::D_INFINITY;
+
+        AllPairsShortestPaths(
+            AllPairsShortestPathsImpl<weight_lt>&& shortest_paths,
+            const Graph<Impl, Vertex, IsDirected, weight_lt>& graph
+        )
+            : _shortest_paths(std::move(shortest_paths))
+            , graph(graph) {}
+
+        auto size() const { return _shortest_paths.size(); }
+
+        bool is_reachable(const Vertex& start, const Vertex& end) const {
+            return get_distance(start, end) != D_INFINITY;
+        }
+
+        weight_lt get_distance(const Vertex& start, const Vertex& end) const {
+            assert(graph.get_internal_index(start) != INVALID_VERTEX);
+            assert(graph.get_internal_index(end) != INVALID_VERTEX);
+            return _shortest_paths.get_distance(graph.get_internal_index(start), graph.get_internal_index(end));
+        }
+
+        /** @throw error if the next hops have not been computed */
+        generator<step_lt> get_path(const Vertex& start, const Vertex& end) const {
+            assert(graph.get_internal_index(start) != INVALID_VERTEX);
+            assert(graph.get_internal_index(end) != INVALID_VERTEX);
+            auto sp = _shortest_paths.get_path(graph.get_internal_index(start), graph.get_internal_index(end));
+            for (const auto& [v, d] : sp) {
+                co_yield std::make_tuple(graph.get_vertex_from_internal_index(v), d);
+            }
+        }
+
+        const AllPairsShortestPathsImpl<weight_lt>& impl() const { return _shortest_paths; }
+
+       private:
+        const AllPairsShortestPathsImpl<weight_lt> _shortest_paths;
+        const Graph<Impl, Vertex, IsDirected, weight_lt>& graph;
+    };
+
+    /**
+     * @brief Compute the shortest paths between all the pairs of vertices
+     * @see all_pairs_shortest_paths_FW(const G&, bool, unsigned)
+     */
+    template <typename Impl, VertexKey Vertex, bool directed>
+        requires GraphImpl<Impl, typename Impl::weight_lt>
+    AllPairsShortestPaths<Impl, Vertex, directed> all_pairs_shortest_paths_FW(
+        const Graph<Impl, Vertex, directed, typename Impl::weight_lt>& graph,
+        bool with_next_hops = false,
+        unsigned n_threads = 0
+    ) {
+        auto sp_impl = all_pairs_shortest_paths_FW(graph.impl(), with_next_hops, n_threads);
+        return AllPairsShortestPaths<Impl, Vertex, directed>(std::move(sp_impl), graph);
+    }
+
+    /**
+     * @brief Compute the shortest paths between all the pairs of vertices
+     * @see all_pairs_shortest_paths_johnson(const G&, bool, unsigned)
+     */
+    template <typename Impl, VertexKey Vertex, bool directed>
+        requires GraphImpl<Impl, typename Impl::weight_lt>
+    AllPairsShortestPaths<Impl, Vertex, directed> all_pairs_shortest_paths_johnson(
+        const Graph<Impl, Vertex, directed, typename Impl::weight_lt>& graph,
+        bool with_next_hops = false,
+        unsigned n_threads = 0
+    ) {
+        auto sp_impl = all_pairs_shortest_paths_johnson(graph.impl(), with_next_hops, n_threads);
+        return AllPairsShortestPaths<Impl, Vertex, directed>(std::move(sp_impl), graph);
+    }
+} // namespace grafology
@@ -1,6 +1,14 @@
 #pragma once
-#include <queue>
 #include "../graph.h"
+#include "../indexed_heap.h"
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <queue>
+#include <ranges>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace grafology {
     //==============================================================================
@@ -78,7 +86,9 @@ namespace grafology {
 
     /**
      * @brief Compute the shortest paths from a vertex to all other vertices in a graph
-     * @remark this is based on the Dijkstra's algorithm
+     * @remark this is based on the Dijkstra's algorithm. The vertices are kept in an indexed heap,
+     * so each vertex is queued at most once and its distance is decreased in place.
+     * @remark For integral weights, the heap is a radix heap (see DijkstraHeap)
      */
     template <typename G>
         requires GraphImpl<G, typename G::weight_lt>
@@ -89,68 +99,431 @@ namespace grafology {
 
         const auto n_vertices = graph.size();
         AllShortestPathsImpl<weight_lt> res(n_vertices, start);
-        std::priority_queue<std::pair<weight_lt, vertex_t>> pq;
+        typename DijkstraHeap<weight_lt>::type heap(n_vertices);
 
         res._distances[start] = 0;
-        pq.push({0, start});
-        while (!pq.empty()) {
-            if (pq.empty()) {
-                break;
-            }
-            auto [d, v] = pq.top();
-            pq.pop();
-            if (d > res._distances[v]) {
-                continue;
-            }
-            for (const auto& edge : graph.get_neighbors(v)) {
+        heap.push(start, 0);
+        while (!heap.empty()) {
+            auto [d, v] = heap.pop();
+            for_each_neighbor(graph, v, [&](const auto& edge) {
                 // Dijkstra's algorithm doesn't work with negative weights
                 assert(edge.weight > 0);
                 auto new_d = d + edge.weight;
                 if (new_d < res._distances[edge.end]) {
                     res._distances[edge.end] = new_d;
                     res._predecessors[edge.end] = v;
-                    pq.push({new_d, edge.end});
+                    heap.push_or_decrease(edge.end, new_d);
                 }
-            }
+            });
         }
         return res;
     }
 
+    namespace internal {
+        /**
+         * @brief The Dijkstra's algorithm with a workspace (result, heap) reused for several sources
+         * @details only the vertices reached by the previous run are reset, so a run only costs
+         * O(m log n) for the reached part of the graph, without any allocation.
+         * The weights must be non-negative.
+         */
+        template <typename G>
+        class DijkstraSearch {
+           public:
+            using weight_lt = typename G::weight_lt;
+            static constexpr auto D_INFINITY = edge_t<weight_lt>::D_INFINITY;
+
+            DijkstraSearch(const G& graph)
+                : _graph(graph)
+                , _res(graph.size(), 0)
+                , _heap(graph.size()) {}
+
+            /** @brief compute the shortest paths from start. The result is valid until the next run */
+            const AllShortestPathsImpl<weight_lt>& run(vertex_t start) {
+                assert(start < _graph.size());
+                for (auto v : _settled) {
+                    _res._distances[v] = D_INFINITY;
+                    _res._predecessors[v] = NO_PREDECESSOR;
+                }
+                _settled.clear();
+                _heap.clear();
+
+                _res._start = start;
+                _res._distances[start] = 0;
+                _heap.push(start, 0);
+                while (!_heap.empty()) {
+                    auto [d, v] = _heap.pop();
+                    _settled.push_back(v);
+                    for_each_neighbor(_graph, v, [&](const auto& edge) {
+                        assert(edge.weight >= 0);
+                        auto new_d = d + edge.weight;
+                        if (new_d < _res._distances[edge.end]) {
+                            _res._distances[edge.end] = new_d;
+                            _res._predecessors[edge.end] = v;
+                            _heap.push_or_decrease(edge.end, new_d);
+                        }
+                    });
+                }
+                return _res;
+            }
+
+            /** @brief the vertices reached by the last run, in the order they have been settled */
+            const std::vector<vertex_t>& settled() const { return _settled; }
+
+           protected:
+            const G& _graph;
+            AllShortestPathsImpl<weight_lt> _res;
+            typename DijkstraHeap<weight_lt>::type _heap;
+            std::vector<vertex_t> _settled;
+        };
+
+        /**
+         * @brief call f(search, source) for each source, with a search (workspace) created by
+         * make_search() for each thread
+         * @details the sources are taken one by one by the threads, which balances the work when
+         * the number of reached vertices differs between the sources. If f throws, the threads stop
+         * and the first exception is thrown again.
+         * @param n_threads the number of threads (0 for the hardware concurrency)
+         */
+        template <std::ranges::random_access_range Sources, typename MakeSearch, typename F>
+        void for_each_source(const Sources& sources, MakeSearch&& make_search, F&& f, unsigned n_threads) {
+            const std::size_t n_sources = std::ranges::size(sources);
+            if (n_threads == 0) {
+                n_threads = std::max(1u, std::thread::hardware_concurrency());
+            }
+            n_threads = std::max<std::size_t>(1, std::min<std::size_t>(n_threads, n_sources));
+
+            std::atomic<std::size_t> next_source = 0;
+            std::exception_ptr exception;
+            std::mutex exception_mutex;
+            auto worker = [&] {
+                try {
+                    auto search = make_search();
+                    for (auto i = next_source++; i < n_sources; i = next_source++) {
+                        f(search, static_cast<vertex_t>(std::ranges::begin(sources)[i]));
+                    }
+                } catch (...) {
+                    std::lock_guard lock(exception_mutex);
+                    if (!exception) {
+                        exception = std::current_exception();
+                    }
+                    // the other threads don't take any new source
+                    next_source = n_sources;
+                }
+            };
+
+            {
+                std::vector<std::jthread> threads;
+                threads.reserve(n_threads - 1);
+                for (unsigned t = 1; t < n_threads; ++t) {
+                    threads.emplace_back(worker);
+                }
+                worker();
+            }
+            if (exception) {
+                std::rethrow_exception(exception);
+            }
+        }
+    } // namespace internal
+
+    /**
+     * @brief Compute the shortest paths from each source of a batch, and pass them to f
+     * @details f(source, paths) is called for each source, with the shortest paths from this source
+     * (AllShortestPathsImpl). The sources are shared between the threads, each one reusing its own
+     * workspace (see internal::DijkstraSearch), so that the results don't need to be all kept in memory.
+     * @remark f is called concurrently by the threads, and paths is only valid during the call
+     * @remark this is based on the Dijkstra's algorithm: the weights must be non-negative
+     * @param n_threads the number of threads (0 for the hardware concurrency, 1 for the calling thread only)
+     * @throw the first exception thrown by f
+     */
+    template <typename G, std::ranges::random_access_range Sources, typename F>
+        requires GraphImpl<G, typename G::weight_lt>
+              && std::convertible_to<std::ranges::range_value_t<Sources>, vertex_t>
+              && std::invocable<F&, vertex_t, const AllShortestPathsImpl<typename G::weight_lt>&>
+    void all_shortest_paths(const G& graph, const Sources& sources, F&& f, unsigned n_threads = 0) {
+        internal::for_each_source(
+            sources,
+            [&graph] { return internal::DijkstraSearch<G>(graph); },
+            [&f](auto& search, vertex_t start) { f(start, search.run(start)); },
+            n_threads
+        );
+    }
+
+    namespace internal {
+        /**
+         * @brief throw if a vertex reachable from the start has a negative self loop
+         * @remark for_each_neighbor() skips the self loops, so the Bellman-Ford algorithms check them apart
+         */
+        template <typename G>
+        void check_negative_self_loops(const G& graph, const AllShortestPathsImpl<typename G::weight_lt>& res) {
+            for (vertex_t v = 0; v < graph.size(); ++v) {
+                if (res.is_reachable(v) && graph.weight(v, v) < 0) {
+                    throw std::runtime_error("Negative cycle detected");
+                }
+            }
+        }
+    } // namespace internal
+
     /**
      * @brief Compute the shortest paths from a vertex to all other vertices in a graph
-     * @remark this is based on the Bellman-Ford algorithm
+     * @remark this is based on the Bellman-Ford algorithm. The edges are relaxed by rounds, and the
+     * algorithm stops as soon as a round doesn't change any distance.
+     * @throw std::runtime_error if the graph is undirected or if a negative cycle is reachable from start
      */
     template <typename G>
         requires GraphImpl<G, typename G::weight_lt>
     AllShortestPathsImpl<typename G::weight_lt>
     all_shortest_paths_BF(const G& graph, vertex_t start) {
-      assert(start < graph.size());
-
-      if (!graph.is_directed()) {
-          throw std::runtime_error("Bellman-Ford algorithm only works with directed graphs");
-      }
-
-      using weight_lt = typename G::weight_lt;
-      static constexpr auto D_INFINITY = edge_t<weight_lt>::D_INFINITY;
-
-      const auto n_vertices = graph.size();
-      AllShortestPathsImpl<weight_lt> res(n_vertices, start);
-      res._distances[start] = 0;
-      for (auto idx = 0; idx < n_vertices; ++idx) {
-          for (const auto edge : graph.get_all_edges()) {
-              if (res._distances[edge.start] != D_INFINITY) {
-                  auto new_d = res._distances[edge.start] + edge.weight;
-                  if (new_d < res._distances[edge.end]) {
-                      if (idx == n_vertices - 1) {
-                          throw std::runtime_error("Negative cycle detected");
-                      }
-                      res._distances[edge.end] = new_d;
-                      res._predecessors[edge.end] = edge.start;
-                  }
-              }
-          }
-      }
-      return res;
+        assert(start < graph.size());
+
+        if (!graph.is_directed()) {
+            throw std::runtime_error("Bellman-Ford algorithm only works with directed graphs");
+        }
+
+        using weight_lt = typename G::weight_lt;
+        static constexpr auto D_INFINITY = edge_t<weight_lt>::D_INFINITY;
+
+        const auto n_vertices = graph.size();
+        AllShortestPathsImpl<weight_lt> res(n_vertices, start);
+        res._distances[start] = 0;
+        for (vertex_t round = 0; round < n_vertices; ++round) {
+            bool has_changed = false;
+            for (vertex_t v = 0; v < n_vertices; ++v) {
+                if (res._distances[v] == D_INFINITY) {
+                    continue;
+                }
+                for_each_neighbor(graph, v, [&](const auto& edge) {
+                    auto new_d = res._distances[v] + edge.weight;
+                    if (new_d < res._distances[edge.end]) {
+                        // a shortest path has at most n_vertices - 1 edges
+                        if (round == n_vertices - 1) {
+                            throw std::runtime_error("Negative cycle detected");
+                        }
+                        res._distances[edge.end] = new_d;
+                        res._predecessors[edge.end] = v;
+                        has_changed = true;
+                    }
+                });
+            }
+            if (!has_changed) {
+                break;
+            }
+        }
+        internal::check_negative_self_loops(graph, res);
+        return res;
+    }
+
+    /**
+     * @brief Compute the shortest paths from a vertex to all other vertices in a graph
+     * @remark this is the queue-based Bellman-Ford algorithm (SPFA): only the edges of the vertices whose
+     * distance has decreased are relaxed again. Each vertex is at most once in the queue.
+     * @remark the number of edges of the path found for each vertex is updated with each relaxation.
+     * A path with n_vertices edges contains a cycle, which can only be negative.
+     * @throw std::runtime_error if the graph is undirected or if a negative cycle is reachable from start
+     */
+    template <typename G>
+        requires GraphImpl<G, typename G::weight_lt>
+    AllShortestPathsImpl<typename G::weight_lt>
+    all_shortest_paths_SPFA(const G& graph, vertex_t start) {
+        assert(start < graph.size());
+
+        if (!graph.is_directed()) {
+            throw std::runtime_error("Bellman-Ford algorithm only works with directed graphs");
+        }
+
+        using weight_lt = typename G::weight_lt;
+
+        const auto n_vertices = graph.size();
+        AllShortestPathsImpl<weight_lt> res(n_vertices, start);
+        std::vector<vertex_t> path_lengths(n_vertices, 0);
+        std::vector<bool> is_queued(n_vertices, false);
+        std::queue<vertex_t> queue;
+
+        res._distances[start] = 0;
+        queue.push(start);
+        is_queued[start] = true;
+        while (!queue.empty()) {
+            auto v = queue.front();
+            queue.pop();
+            is_queued[v] = false;
+            for_each_neighbor(graph, v, [&](const auto& edge) {
+                auto new_d = res._distances[v] + edge.weight;
+                if (new_d < res._distances[edge.end]) {
+                    path_lengths[edge.end] = path_lengths[v] + 1;
+                    if (path_lengths[edge.end] >= n_vertices) {
+                        throw std::runtime_error("Negative cycle detected");
+                    }
+                    res._distances[edge.end] = new_d;
+                    res._predecessors[edge.end] = v;
+                    if (!is_queued[edge.end]) {
+                        queue.push(edge.end);
+                        is_queued[edge.end] = true;
+                    }
+                }
+            });
+        }
+        internal::check_negative_self_loops(graph, res);
+        return res;
+    }
+
+    /**
+     * @brief The bounds of a search of the shortest paths from a vertex (see all_shortest_paths())
+     * @details the search stops as soon as one of the bounds is reached
+     */
+    template <typename weight_t, typename Vertex = vertex_t>
+    struct ShortestPathsBounds {
+        static constexpr std::size_t NO_MAX_HOPS = std::numeric_limits<std::size_t>::max();
+
+        /** @brief the search stops once all the targets are settled (if there are targets) */
+        std::vector<Vertex> targets {};
+        /** @brief the vertices farther than max_distance are not settled */
+        weight_t max_distance = edge_t<weight_t>::D_INFINITY;
+        /** @brief the vertices whose shortest path has more than max_hops edges are not kept */
+        std::size_t max_hops = NO_MAX_HOPS;
+    };
+
+    /**
+     * @brief This struct allows to process the results of a bounded search of the shortest paths
+     * @details only the vertices settled by the search are stored, in a hash map, so the memory is
+     * proportional to the explored part of the graph and not to the size of the graph
+     */
+    template <typename weight_t>
+    struct BoundedShortestPathsImpl {
+        static constexpr auto D_INFINITY = edge_t<weight_t>::D_INFINITY;
+        using step_lt = std::tuple<vertex_t, weight_t>;
+
+        struct Entry {
+            weight_t distance;
+            vertex_t predecessor;
+            // the number of edges of the path
+            std::size_t hops;
+        };
+
+        explicit BoundedShortestPathsImpl(vertex_t start)
+            : _start(start) {}
+
+        /** @brief the number of vertices found */
+        auto size() const { return _vertices.size(); }
+
+        /** @brief the vertices found, by increasing distance */
+        const std::vector<vertex_t>& vertices() const { return _vertices; }
+
+        /** @brief true if the vertex has been found within the bounds */
+        bool is_reachable(vertex_t end) const { return _entries.contains(end); }
+
+        /** @brief the distance to a vertex, D_INFINITY if it has not been found within the bounds */
+        weight_t get_distance(vertex_t end) const {
+            auto it = _entries.find(end);
+            return it == _entries.end() ? D_INFINITY : it->second.distance;
+        }
+
+        vertex_t get_predecessor(vertex_t end) const {
+            auto it = _entries.find(end);
+            return it == _entries.end() ? NO_PREDECESSOR : it->second.predecessor;
+        }
+
+        std::vector<step_lt> get_path(vertex_t end) const {
+            std::vector<step_lt> path;
+            if (!is_reachable(end)) {
+                return path;
+            }
+            for (auto current = end; current != _start;) {
+                const auto& entry = _entries.at(current);
+                path.push_back(std::make_tuple(current, entry.distance));
+                current = entry.predecessor;
+            }
+            path.push_back(std::make_tuple(_start, 0));
+            std::ranges::reverse(path);
+            return path;
+        }
+
+        vertex_t _start;
+        std::unordered_map<vertex_t, Entry> _entries;
+        std::vector<vertex_t> _vertices;
+    };
+
+    /**
+     * @brief Compute the shortest paths from a vertex to the vertices within some bounds
+     * @details The Dijkstra's algorithm stops as soon as:
+     * - all the targets are settled
+     * - or the next vertex is farther than max_distance
+     * - or no vertex left in the queue has a path with at most max_hops edges (the paths can only
+     * get longer)
+     *
+     * Among the shortest paths of a vertex, the one with the fewest edges is kept, and the vertex is
+     * only kept if this path has at most max_hops edges.
+     * @remark the distances and the queue are stored in hash maps: the cost of a search is
+     * proportional to the explored part of the graph, without any array of the size of the graph
+     * @remark the weights must be positive
+     */
+    template <typename G>
+        requires GraphImpl<G, typename G::weight_lt>
+    BoundedShortestPathsImpl<typename G::weight_lt> all_shortest_paths(
+        const G& graph,
+        vertex_t start,
+        const ShortestPathsBounds<typename G::weight_lt>& bounds
+    ) {
+        using weight_lt = typename G::weight_lt;
+        using queue_entry = std::pair<weight_lt, vertex_t>;
+        static constexpr auto D_INFINITY = edge_t<weight_lt>::D_INFINITY;
+
+        assert(start < graph.size());
+
+        struct State : BoundedShortestPathsImpl<weight_lt>::Entry {
+            bool is_settled;
+        };
+        std::unordered_map<vertex_t, State> states;
+        // NB: the outdated entries are skipped when they are popped
+        std::priority_queue<queue_entry, std::vector<queue_entry>, std::greater<>> queue;
+        const std::unordered_set<vertex_t> targets(bounds.targets.begin(), bounds.targets.end());
+        std::size_t n_targets_left = targets.size();
+        // the number of queued vertices whose path has at most max_hops edges
+        std::size_t n_within_hops = 0;
+
+        BoundedShortestPathsImpl<weight_lt> res(start);
+        states.emplace(start, State{{0, NO_PREDECESSOR, 0}, false});
+        queue.push({0, start});
+        n_within_hops = 1;
+        while (!queue.empty() && n_within_hops > 0) {
+            auto [d, v] = queue.top();
+            queue.pop();
+            auto& state = states.at(v);
+            if (state.is_settled || d > state.distance) {
+                continue;
+            }
+            state.is_settled = true;
+            const auto hops = state.hops;
+            if (hops <= bounds.max_hops) {
+                --n_within_hops;
+                res._entries.emplace(v, state);
+                res._vertices.push_back(v);
+                if (targets.contains(v) && --n_targets_left == 0) {
+                    break;
+                }
+            }
+            for_each_neighbor(graph, v, [&](const auto& edge) {
+                assert(edge.weight > 0);
+                auto new_d = d + edge.weight;
+                if (new_d > bounds.max_distance) {
+                    return;
+                }
+                auto [it, is_new] = states.try_emplace(edge.end, State{{D_INFINITY, NO_PREDECESSOR, 0}, false});
+                auto& other = it->second;
+                if (other.is_settled) {
+                    return;
+                }
+                if (new_d < other.distance || (new_d == other.distance && hops + 1 < other.hops)) {
+                    n_within_hops -= !is_new && other.hops <= bounds.max_hops;
+                    n_within_hops += hops + 1 <= bounds.max_hops;
+                    if (new_d < other.distance) {
+                        queue.push({new_d, edge.end});
+                    }
+                    other.distance = new_d;
+                    other.predecessor = v;
+                    other.hops = hops + 1;
+                }
+            });
+        }
+        return res;
     }
 
     //==============================================================================
@@ -230,7 +603,7 @@ namespace grafology {
         const Vertex& start
     ) {
         assert(graph.get_internal_index(start) != INVALID_VERTEX);
-        auto sp_impl = all_shortest_paths(graph.impl(), graph.get_internal_index(start));
+        auto sp_impl = all_shortest_paths_BF(graph.impl(), graph.get_internal_index(start));
         return AllShortestPaths<Impl, Vertex, true>(std::move(sp_impl), graph);
     }
 
@@ -243,4 +616,99 @@ namespace grafology {
       static_assert(false, "Bellman-Ford algorithm only works with directed graphs");
     }
 
+    template <typename Impl, VertexKey Vertex>
+        requires GraphImpl<Impl, typename Impl::weight_lt>
+    AllShortestPaths<Impl, Vertex, true> all_shortest_paths_SPFA(
+        const Graph<Impl, Vertex, true, typename Impl::weight_lt>& graph,
+        const Vertex& start
+    ) {
+        assert(graph.get_internal_index(start) != INVALID_VERTEX);
+        auto sp_impl = all_shortest_paths_SPFA(graph.impl(), graph.get_internal_index(start));
+        return AllShortestPaths<Impl, Vertex, true>(std::move(sp_impl), graph);
+    }
+
+    template <typename Impl, VertexKey Vertex>
+        requires GraphImpl<Impl, typename Impl::weight_lt>
+    AllShortestPaths<Impl, Vertex, false> all_shortest_paths_SPFA(
+        const Graph<Impl, Vertex, false, typename Impl::weight_lt>& graph,
+        const Vertex& start
+    ) {
+      static_assert(false, "Bellman-Ford algorithm only works with directed graphs");
+    }
+
+    /**
+     * @brief The shortest paths from a vertex to the vertices within some bounds
+     */
+    template <typename Impl, VertexKey Vertex, bool IsDirected>
+        requires GraphImpl<Impl, typename Impl::weight_lt>
+    struct BoundedShortestPaths {
+        using weight_lt = typename Impl::weight_lt;
+        using step_lt = Step<Vertex, weight_lt>;
+        static constexpr auto D_INFINITY = edge_t<weight_lt>::D_INFINITY;
+
+        BoundedShortestPaths(
+            BoundedShortestPathsImpl<weight_lt>&& shortest_paths,
+            const Graph<Impl, Vertex, IsDirected, weight_lt>& graph
+        )
+            : _shortest_paths(std::move(shortest_paths))
+            , graph(graph) {}
+
+        /** @brief the number of vertices found */
+        auto size() const { return _shortest_paths.size(); }
+
+        bool is_reachable(const Vertex& v) const {
+            assert(graph.get_internal_index(v) != INVALID_VERTEX);
+            return _shortest_paths.is_reachable(graph.get_internal_index(v));
+        }
+
+        weight_lt get_distance(const Vertex& v) const {
+            assert(graph.get_internal_index(v) != INVALID_VERTEX);
+            return _shortest_paths.get_distance(graph.get_internal_index(v));
+        }
+
+        /** @brief the vertices found with their distance, by increasing distance */
+        generator<step_lt> get_vertices() const {
+            for (auto v : _shortest_paths.vertices()) {
+                co_yield std::make_tuple(graph.get_vertex_from_internal_index(v), _shortest_paths.get_distance(v));
+            }
+        }
+
+        generator<step_lt> get_path(const Vertex& v) const {
+            assert(graph.get_internal_index(v) != INVALID_VERTEX);
+            auto sp = _shortest_paths.get_path(graph.get_internal_index(v));
+            for (const auto& [v, d] : sp) {
+                co_yield std::make_tuple(graph.get_vertex_from_internal_index(v), d);
+            }
+        }
+
+       private:
+        const BoundedShortestPathsImpl<weight_lt> _shortest_paths;
+        const Graph<Impl, Vertex, IsDirected, weight_lt>& graph;
+    };
+
+    /**
+     * @brief Compute the shortest paths from a vertex to the vertices within some bounds
+     * @see all_shortest_paths(const G&, vertex_t, const ShortestPathsBounds<typename G::weight_lt>&)
+     */
+    template <typename Impl, VertexKey Vertex, bool directed>
+        requires GraphImpl<Impl, typename Impl::weight_lt>
+    BoundedShortestPaths<Impl, Vertex, directed> all_shortest_paths(
+        const Graph<Impl, Vertex, directed, typename Impl::weight_lt>& graph,
+        const Vertex& start,
+        const std::type_identity_t<ShortestPathsBounds<typename Impl::weight_lt, Vertex>>& bounds
+    ) {
+        assert(graph.get_internal_index(start) != INVALID_VERTEX);
+        ShortestPathsBounds<typename Impl::weight_lt> impl_bounds {
+            .targets = {},
+            .max_distance = bounds.max_distance,
+            .max_hops = bounds.max_hops
+        };
+        for (const auto& target : bounds.targets) {
+            assert(graph.get_internal_index(target) != INVALID_VERTEX);
+            impl_bounds.targets.push_back(graph.get_internal_index(target));
+        }
+        auto sp_impl = all_shortest_paths(graph.impl(), graph.get_internal_index(start), impl_bounds);
+        return BoundedShortestPaths<Impl, Vertex, directed>(std::move(sp_impl), graph);
+    }
+
   }  // namespace grafology
@@ -46,7 +46,8 @@ namespace grafology {
                         auto p = parent[v];
                         discovery_time[v] = lowest_time[v] = time;
                         ++time;
-                        for (auto w : graph.get_raw_neighbors(v)) {
+                        for_each_neighbor(graph, v, [&](const auto& edge) {
+                            auto w = edge.end;
                             if (discovery_time[w] == UNDEFINED) {
                                 parent[w] = v;
                                 stack.push({w, false});
@@ -54,7 +55,7 @@ namespace grafology {
                             } else if (w != p) {
                                 lowest_time[v] = std::min(lowest_time[v], discovery_time[w]);
                             }
-                        }
+                        });
                     } else {
                         // v has been updated, so one can now update the parent
                         auto p = parent[v];
@@ -16,9 +16,9 @@ namespace grafology {
             if (!visited[current]) {
                 visited[current] = true;
                 co_yield current;
-                for (auto neighbour : graph.get_raw_neighbors(current)) {
-                    queue.push(neighbour);
-                }
+                for_each_neighbor(graph, current, [&](const auto& edge) {
+                    queue.push(edge.end);
+                });
             }
         }
     }
@@ -0,0 +1,520 @@
+#pragma once
+#include "shortest_path.h"
+#include "../indexed_heap.h"
+#include <algorithm>
+#include <span>
+#include <vector>
+
+namespace grafology {
+    //==============================================================================
+    // Implementation Graphs
+    //==============================================================================
+
+    /**
+     * @brief The contraction hierarchy of a graph, which answers the shortest path queries on a static graph
+     * @details The vertices are contracted one by one, from the least important one (the rank of a vertex
+     * is its position in this order). When a vertex is contracted, shortcuts are added between its neighbors
+     * so that the distances between the remaining vertices don't change. Then any shortest path can be found
+     * with a bidirectional search which only goes up the hierarchy, and which explores very few vertices.
+     *
+     * The edges are stored in two compact CSR:
+     * - the upward edges (v -> w) with rank(v) < rank(w), stored at v, for the search from start
+     * - the downward edges (u -> v) with rank(u) > rank(v), stored at v, for the search from end
+     *
+     * @remark use contraction_hierarchy() to build it and ContractionHierarchyQuery to run the queries
+     */
+    template <typename weight_t>
+    struct ContractionHierarchyImpl {
+        /**
+         * @brief an edge of the hierarchy
+         * @details vertex is the other end of the edge (the end of an upward edge, the start of a downward edge).
+         * middle is the vertex whose contraction added the shortcut (INVALID_VERTEX for the edges of the graph).
+         */
+        struct Arc {
+            vertex_t vertex;
+            weight_t weight;
+            vertex_t middle;
+        };
+
+        auto size() const { return _ranks.size(); }
+
+        std::size_t n_shortcuts() const { return _n_shortcuts; }
+
+        /** @brief the edges (v -> w) with rank(v) < rank(w) */
+        std::span<const Arc> get_up_arcs(vertex_t v) const {
+            assert(v < size());
+            return {_up_arcs.data() + _up_offsets[v], _up_arcs.data() + _up_offsets[v + 1]};
+        }
+
+        /** @brief the edges (u -> v) with rank(u) > rank(v) */
+        std::span<const Arc> get_down_arcs(vertex_t v) const {
+            assert(v < size());
+            return {_down_arcs.data() + _down_offsets[v], _down_arcs.data() + _down_offsets[v + 1]};
+        }
+
+        /** @brief the edge (u -> w) of the hierarchy */
+        const Arc& get_arc(vertex_t u, vertex_t w) const {
+            const auto arcs = _ranks[u] < _ranks[w] ? get_up_arcs(u) : get_down_arcs(w);
+            const auto other = _ranks[u] < _ranks[w] ? w : u;
+            auto it = std::ranges::find(arcs, other, &Arc::vertex);
+            assert(it != arcs.end());
+            return *it;
+        }
+
+        std::vector<vertex_t> _ranks;
+        std::vector<std::size_t> _up_offsets;
+        std::vector<Arc> _up_arcs;
+        std::vector<std::size_t> _down_offsets;
+        std::vector<Arc> _down_arcs;
+        std::size_t _n_shortcuts = 0;
+    };
+
+    namespace internal {
+        /**
+         * @brief Build a contraction hierarchy
+         * @details The vertices are ordered by their edge difference (the number of shortcuts added minus the
+         * number of edges removed by the contraction) plus the number of their contracted neighbors, which
+         * spreads the contractions over the graph. The priorities are updated lazily: the priority of the
+         * vertex at the top of the queue is recomputed, and it is contracted only if it is still the lowest.
+         *
+         * A shortcut (u -> w) through v is only added if there is no other path from u to w, as short as
+         * (u -> v -> w), which is found by a Dijkstra's search (the witness search) limited to
+         * MAX_WITNESS_SETTLED vertices. A limited search can add useless shortcuts, but never misses one.
+         */
+        template <typename weight_t>
+        class ContractionHierarchyBuilder {
+            using Arc = typename ContractionHierarchyImpl<weight_t>::Arc;
+            static constexpr auto D_INFINITY = edge_t<weight_t>::D_INFINITY;
+            static constexpr std::size_t MAX_WITNESS_SETTLED = 500;
+
+        public:
+            template <typename G>
+            ContractionHierarchyBuilder(const G& graph)
+                : _out(graph.size())
+                , _in(graph.size())
+                , _n_contracted_neighbors(graph.size(), 0)
+                , _witness_distances(graph.size(), D_INFINITY)
+                , _witness_heap(graph.size())
+                , _is_target(graph.size(), false) {
+                for (vertex_t v = 0; v < graph.size(); ++v) {
+                    for_each_neighbor(graph, v, [&](const auto& edge) {
+                        if (edge.weight <= 0) {
+                            throw error("Contraction hierarchy: negative weights are not allowed");
+                        }
+                        add_arc(v, edge.end, edge.weight, INVALID_VERTEX);
+                    });
+                }
+            }
+
+            ContractionHierarchyImpl<weight_t> build() {
+                const auto n_vertices = _out.size();
+                ContractionHierarchyImpl<weight_t> res;
+                res._ranks.resize(n_vertices);
+                // the remaining edges of a vertex when it is contracted are its upward and downward edges
+                std::vector<std::vector<Arc>> up(n_vertices);
+                std::vector<std::vector<Arc>> down(n_vertices);
+
+                IndexedDAryHeap<long> queue(n_vertices);
+                for (vertex_t v = 0; v < n_vertices; ++v) {
+                    queue.push(v, priority(v));
+                }
+                vertex_t rank = 0;
+                std::vector<std::tuple<vertex_t, vertex_t, weight_t>> shortcuts;
+                while (!queue.empty()) {
+                    auto v = queue.pop().vertex;
+                    auto p = priority(v);
+                    if (!queue.empty() && queue.top().key < p) {
+                        queue.push(v, p);
+                        continue;
+                    }
+                    res._ranks[v] = rank++;
+
+                    shortcuts.clear();
+                    for_each_shortcut(v, [&](vertex_t u, vertex_t w, weight_t weight) {
+                        shortcuts.emplace_back(u, w, weight);
+                    });
+                    for (const auto& arc : _out[v]) {
+                        erase_arc(_in[arc.vertex], v);
+                        ++_n_contracted_neighbors[arc.vertex];
+                    }
+                    for (const auto& arc : _in[v]) {
+                        erase_arc(_out[arc.vertex], v);
+                        ++_n_contracted_neighbors[arc.vertex];
+                    }
+                    up[v] = std::move(_out[v]);
+                    down[v] = std::move(_in[v]);
+                    for (const auto& [u, w, weight] : shortcuts) {
+                        add_arc(u, w, weight, v);
+                    }
+                    res._n_shortcuts += shortcuts.size();
+                }
+
+                to_csr(up, res._up_offsets, res._up_arcs);
+                to_csr(down, res._down_offsets, res._down_arcs);
+                return res;
+            }
+
+        private:
+            /** @brief add the edge (u -> w) or decrease its weight if it already exists */
+            void add_arc(vertex_t u, vertex_t w, weight_t weight, vertex_t middle) {
+                auto it = std::ranges::find(_out[u], w, &Arc::vertex);
+                if (it == _out[u].end()) {
+                    _out[u].push_back({w, weight, middle});
+                    _in[w].push_back({u, weight, middle});
+                } else if (weight < it->weight) {
+                    *it = {w, weight, middle};
+                    *std::ranges::find(_in[w], u, &Arc::vertex) = {u, weight, middle};
+                }
+            }
+
+            static void erase_arc(std::vector<Arc>& arcs, vertex_t v) {
+                auto it = std::ranges::find(arcs, v, &Arc::vertex);
+                assert(it != arcs.end());
+                *it = arcs.back();
+                arcs.pop_back();
+            }
+
+            /** @brief call f(u, w, weight) for each shortcut (u -> w) needed when v is contracted */
+            template <typename F>
+            void for_each_shortcut(vertex_t v, F&& f) {
+                for (const auto& in_arc : _in[v]) {
+                    auto u = in_arc.vertex;
+                    weight_t max_distance = 0;
+                    std::size_t n_targets = 0;
+                    for (const auto& out_arc : _out[v]) {
+                        if (out_arc.vertex != u) {
+                            max_distance = std::max(max_distance, in_arc.weight + out_arc.weight);
+                            _is_target[out_arc.vertex] = true;
+                            ++n_targets;
+                        }
+                    }
+                    if (n_targets == 0) {
+                        continue;
+                    }
+                    witness_search(u, v, max_distance, n_targets);
+                    for (const auto& out_arc : _out[v]) {
+                        auto w = out_arc.vertex;
+                        _is_target[w] = false;
+                        if (w != u && in_arc.weight + out_arc.weight < _witness_distances[w]) {
+                            f(u, w, in_arc.weight + out_arc.weight);
+                        }
+                    }
+                    for (auto x : _witness_touched) {
+                        _witness_distances[x] = D_INFINITY;
+                    }
+                    _witness_touched.clear();
+                }
+            }
+
+            /**
+             * @brief a Dijkstra's search from start which avoids the vertex excluded
+             * @details it is stopped once all the targets are settled or when the distance exceeds max_distance
+             */
+            void witness_search(vertex_t start, vertex_t excluded, weight_t max_distance, std::size_t n_targets) {
+                _witness_heap.clear();
+                _witness_distances[start] = 0;
+                _witness_touched.push_back(start);
+                _witness_heap.push(start, 0);
+                for (std::size_t n_settled = 0; !_witness_heap.empty() && n_settled < MAX_WITNESS_SETTLED; ++n_settled) {
+                    auto [d, x] = _witness_heap.pop();
+                    if (max_distance < d || (_is_target[x] && --n_targets == 0)) {
+                        break;
+                    }
+                    for (const auto& arc : _out[x]) {
+                        auto new_d = d + arc.weight;
+                        if (arc.vertex != excluded && new_d < _witness_distances[arc.vertex]) {
+                            if (_witness_distances[arc.vertex] == D_INFINITY) {
+                                _witness_touched.push_back(arc.vertex);
+                            }
+                            _witness_distances[arc.vertex] = new_d;
+                            _witness_heap.push_or_decrease(arc.vertex, new_d);
+                        }
+                    }
+                }
+            }
+
+            long priority(vertex_t v) {
+                long n_shortcuts = 0;
+                for_each_shortcut(v, [&](vertex_t, vertex_t, weight_t) { ++n_shortcuts; });
+                auto edge_difference = n_shortcuts - static_cast<long>(_in[v].size() + _out[v].size());
+                return edge_difference + static_cast<long>(_n_contracted_neighbors[v]);
+            }
+
+            static void to_csr(const std::vector<std::vector<Arc>>& lists, std::vector<std::size_t>& offsets, std::vector<Arc>& arcs) {
+                offsets.assign(lists.size() + 1, 0);
+                for (std::size_t v = 0; v < lists.size(); ++v) {
+                    offsets[v + 1] = offsets[v] + lists[v].size();
+                }
+                arcs.reserve(offsets.back());
+                for (const auto& list : lists) {
+                    arcs.insert(arcs.end(), list.begin(), list.end());
+                }
+            }
+
+            // the edges between the vertices not contracted yet
+            std::vector<std::vector<Arc>> _out;
+            std::vector<std::vector<Arc>> _in;
+            std::vector<std::size_t> _n_contracted_neighbors;
+            // the workspace of the witness searches
+            std::vector<weight_t> _witness_distances;
+            std::vector<vertex_t> _witness_touched;
+            // NB: the witness searches are short, a d-ary heap is faster than a radix heap for them
+            IndexedDAryHeap<weight_t> _witness_heap;
+            // the out-neighbors of the vertex being contracted
+            std::vector<bool> _is_target;
+        };
+    } // namespace internal
+
+    /**
+     * @brief Build the contraction hierarchy of a graph
+     * @remark the preprocessing is much longer than a Dijkstra's search: it is worth it when many queries
+     * are run on the same graph. The hierarchy must be rebuilt if the graph is modified.
+     * @throw error if a weight is negative
+     */
+    template <typename G>
+        requires GraphImpl<G, typename G::weight_lt>
+    ContractionHierarchyImpl<typename G::weight_lt> contraction_hierarchy(const G& graph) {
+        return internal::ContractionHierarchyBuilder<typename G::weight_lt>(graph).build();
+    }
+
+    /**
+     * @brief The shortest path queries on a contraction hierarchy
+     * @details A query is a bidirectional Dijkstra's search which only follows the upward edges from start
+     * and the downward edges (backward) from end. A vertex is not expanded when a higher vertex gives it
+     * a shorter distance (stall-on-demand). The shortcuts of the path are then unpacked into the edges of
+     * the graph.
+     * @remark the workspace of the searches is reused from one query to the next one and only the vertices
+     * visited by a query are reset, so a query doesn't depend on the size of the graph (except shortest_path()
+     * which returns a ShortestPathsImpl). A query object must not be shared between threads.
+     */
+    template <typename weight_t>
+    class ContractionHierarchyQuery {
+        using Arc = typename ContractionHierarchyImpl<weight_t>::Arc;
+        static constexpr auto D_INFINITY = edge_t<weight_t>::D_INFINITY;
+
+    public:
+        using step_lt = std::tuple<vertex_t, weight_t>;
+
+        ContractionHierarchyQuery(const ContractionHierarchyImpl<weight_t>& hierarchy)
+            : _hierarchy(hierarchy)
+            , _forward(hierarchy.size())
+            , _backward(hierarchy.size()) {}
+
+        /** @brief the distance from start to end (D_INFINITY if end is not reachable) */
+        weight_t distance(vertex_t start, vertex_t end) {
+            search(start, end);
+            return _best;
+        }
+
+        /**
+         * @brief the shortest path from start to end
+         * @return a vector of tuples (vertex, distance from start) like ShortestPathsImpl::get_path()
+         */
+        std::vector<step_lt> get_path(vertex_t start, vertex_t end) {
+            std::vector<step_lt> path;
+            auto meeting = search(start, end);
+            if (meeting == INVALID_VERTEX) {
+                return path;
+            }
+            // the vertices of the hierarchy from start to end
+            std::vector<vertex_t> vertices;
+            for (auto v = meeting; v != NO_PREDECESSOR; v = _forward.predecessors[v]) {
+                vertices.push_back(v);
+            }
+            std::ranges::reverse(vertices);
+            for (auto v = _backward.predecessors[meeting]; v != NO_PREDECESSOR; v = _backward.predecessors[v]) {
+                vertices.push_back(v);
+            }
+
+            path.emplace_back(start, 0);
+            for (std::size_t i = 1; i < vertices.size(); ++i) {
+                unpack(vertices[i - 1], vertices[i], path);
+            }
+            return path;
+        }
+
+        /** @brief the shortest path from start to end, with the same result as shortest_path() */
+        ShortestPathsImpl<weight_t> shortest_path(vertex_t start, vertex_t end) {
+            ShortestPathsImpl<weight_t> res(_hierarchy.size(), end);
+            auto prev = NO_PREDECESSOR;
+            for (const auto& [v, d] : get_path(start, end)) {
+                res._distances[v] = d;
+                res._predecessors[v] = prev;
+                prev = v;
+            }
+            return res;
+        }
+
+    private:
+        struct Search {
+            Search(std::size_t n_vertices)
+                : distances(n_vertices, D_INFINITY)
+                , predecessors(n_vertices, NO_PREDECESSOR)
+                , heap(n_vertices) {}
+
+            void reset() {
+                for (auto v : touched) {
+                    distances[v] = D_INFINITY;
+                    predecessors[v] = NO_PREDECESSOR;
+                }
+                touched.clear();
+                heap.clear();
+                is_done = false;
+            }
+
+            void push(vertex_t v, weight_t d, vertex_t predecessor) {
+                if (distances[v] == D_INFINITY) {
+                    touched.push_back(v);
+                }
+                distances[v] = d;
+                predecessors[v] = predecessor;
+                heap.push_or_decrease(v, d);
+            }
+
+            std::vector<weight_t> distances;
+            std::vector<vertex_t> predecessors;
+            std::vector<vertex_t> touched;
+            typename DijkstraHeap<weight_t>::type heap;
+            bool is_done = false;
+        };
+
+        /** @brief run the bidirectional search and return the vertex where the shortest path is the highest */
+        vertex_t search(vertex_t start, vertex_t end) {
+            assert(start < _hierarchy.size() && end < _hierarchy.size());
+            _forward.reset();
+            _backward.reset();
+            _best = D_INFINITY;
+            vertex_t meeting = INVALID_VERTEX;
+            _forward.push(start, 0, NO_PREDECESSOR);
+            _backward.push(end, 0, NO_PREDECESSOR);
+            if (start == end) {
+                _best = 0;
+                return start;
+            }
+
+            bool is_forward = true;
+            while (!_forward.is_done || !_backward.is_done) {
+                // the directions are alternated until they are done
+                if (is_forward ? _forward.is_done : _backward.is_done) {
+                    is_forward = !is_forward;
+                }
+                const bool is_forward_step = is_forward;
+                is_forward = !is_forward;
+                auto& search = is_forward_step ? _forward : _backward;
+                auto& other = is_forward_step ? _backward : _forward;
+                // the search from start goes up the upward edges, the search from end goes up the downward edges
+                auto get_arcs = [&](vertex_t v) {
+                    return is_forward_step ? _hierarchy.get_up_arcs(v) : _hierarchy.get_down_arcs(v);
+                };
+                auto get_stall_arcs = [&](vertex_t v) {
+                    return is_forward_step ? _hierarchy.get_down_arcs(v) : _hierarchy.get_up_arcs(v);
+                };
+
+                if (search.heap.empty()) {
+                    search.is_done = true;
+                    continue;
+                }
+                auto [d, v] = search.heap.pop();
+                // the vertices queued can't be on a shorter path
+                if (!(d < _best)) {
+                    search.is_done = true;
+                    continue;
+                }
+                // the shortest path to v doesn't go up from v if a higher vertex gives a shorter distance
+                auto is_stalled = std::ranges::any_of(get_stall_arcs(v), [&](const Arc& arc) {
+                    return search.distances[arc.vertex] != D_INFINITY && search.distances[arc.vertex] + arc.weight < d;
+                });
+                if (is_stalled) {
+                    continue;
+                }
+                for (const auto& arc : get_arcs(v)) {
+                    auto new_d = d + arc.weight;
+                    if (new_d < search.distances[arc.vertex]) {
+                        search.push(arc.vertex, new_d, v);
+                        if (other.distances[arc.vertex] != D_INFINITY && new_d + other.distances[arc.vertex] < _best) {
+                            _best = new_d + other.distances[arc.vertex];
+                            meeting = arc.vertex;
+                        }
+                    }
+                }
+            }
+            return meeting;
+        }
+
+        /** @brief append the vertices of the edge (u -> w) of the hierarchy to path, without u */
+        void unpack(vertex_t u, vertex_t w, std::vector<step_lt>& path) const {
+            const auto& arc = _hierarchy.get_arc(u, w);
+            if (arc.middle == INVALID_VERTEX) {
+                path.emplace_back(w, std::get<1>(path.back()) + arc.weight);
+                return;
+            }
+            unpack(u, arc.middle, path);
+            unpack(arc.middle, w, path);
+        }
+
+        const ContractionHierarchyImpl<weight_t>& _hierarchy;
+        Search _forward;
+        Search _backward;
+        weight_t _best = D_INFINITY;
+    };
+
+    //==============================================================================
+    // Graphs
+    //==============================================================================
+
+    /**
+     * @brief The contraction hierarchy of a graph, which answers the shortest path queries on a static graph
+     * @see ContractionHierarchyImpl
+     */
+    template <typename Impl, VertexKey Vertex, bool IsDirected>
+        requires GraphImpl<Impl, typename Impl::weight_lt>
+    class ContractionHierarchy {
+    public:
+        using weight_lt = typename Impl::weight_lt;
+
+        ContractionHierarchy(
+            ContractionHierarchyImpl<weight_lt>&& hierarchy,
+            const Graph<Impl, Vertex, IsDirected, weight_lt>& graph
+        )
+            : _hierarchy(std::move(hierarchy))
+            , graph(graph) {}
+
+        auto size() const { return _hierarchy.size(); }
+
+        const ContractionHierarchyImpl<weight_lt>& impl() const { return _hierarchy; }
+
+        /**
+         * @brief the shortest path from start to end, with the same result as shortest_path()
+         * @remark for running many queries, use a ContractionHierarchyQuery on impl() which reuses its workspace
+         */
+        ShortestPaths<Impl, Vertex, IsDirected> shortest_path(const Vertex& start, const Vertex& end) const {
+            assert(graph.get_internal_index(start) != INVALID_VERTEX && graph.get_internal_index(end) != INVALID_VERTEX);
+            ContractionHierarchyQuery<weight_lt> query(_hierarchy);
+            auto sp_impl = query.shortest_path(graph.get_internal_index(start), graph.get_internal_index(end));
+            return ShortestPaths<Impl, Vertex, IsDirected>(std::move(sp_impl), graph);
+        }
+
+        /** @brief the distance from start to end (D_INFINITY if end is not reachable) */
+        weight_lt distance(const Vertex& start, const Vertex& end) const {
+            assert(graph.get_internal_index(start) != INVALID_VERTEX && graph.get_internal_index(end) != INVALID_VERTEX);
+            ContractionHierarchyQuery<weight_lt> query(_hierarchy);
+            return query.distance(graph.get_internal_index(start), graph.get_internal_index(end));
+        }
+
+    private:
+        ContractionHierarchyImpl<weight_lt> _hierarchy;
+        const Graph<Impl, Vertex, IsDirected, weight_lt>& graph;
+    };
+
+    /**
+     * @brief Build the contraction hierarchy of a graph
+     * @see contraction_hierarchy(const G&)
+     */
+    template <typename Impl, VertexKey Vertex, bool directed>
+        requires GraphImpl<Impl, typename Impl::weight_lt>
+    ContractionHierarchy<Impl, Vertex, directed> contraction_hierarchy(
+        const Graph<Impl, Vertex, directed, typename Impl::weight_lt>& graph
+    ) {
+        return ContractionHierarchy<Impl, Vertex, directed>(contraction_hierarchy(graph.impl()), graph);
+    }
+} // namespace grafology
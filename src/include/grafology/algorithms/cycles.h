@@ -1,5 +1,9 @@
 #pragma once
 #include "all_shortest_paths.h"
+#include <algorithm>
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace grafology {
 
@@ -59,4 +63,416 @@ namespace grafology {
             }
         }
     }
+
+    namespace internal {
+        /**
+         * @brief The shortest path tree of the negative cycles detection, stored as a preorder thread
+         * @details The subtree of a vertex is the contiguous range of vertices following it in the thread
+         * with a greater depth. The root (index n) is a virtual source linked to all the vertices.
+         */
+        struct ShortestPathTree {
+            explicit ShortestPathTree(vertex_t n)
+                : root(n)
+                , next(n + 1)
+                , prev(n + 1)
+                , depth(n + 1, 1)
+                , in_tree(n + 1, true) {
+                for (vertex_t v = 0; v <= n; ++v) {
+                    next[v] = v == n ? 0 : v + 1;
+                    prev[v] = v == 0 ? n : v - 1;
+                }
+                depth[root] = 0;
+            }
+
+            /** @brief check if u is a descendant of v (or v itself) */
+            bool is_in_subtree(vertex_t u, vertex_t v) const {
+                if (!in_tree[v] || !in_tree[u]) {
+                    return false;
+                }
+                if (u == v) {
+                    return true;
+                }
+                for (auto x = next[v]; depth[x] > depth[v]; x = next[x]) {
+                    if (x == u) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            /** @brief the last vertex of the subtree of v in the thread */
+            vertex_t get_last(vertex_t v) const {
+                auto last = v;
+                for (auto x = next[v]; depth[x] > depth[v]; x = next[x]) {
+                    last = x;
+                }
+                return last;
+            }
+
+            /** @brief remove v and its descendants from the tree */
+            void remove_subtree(vertex_t v) {
+                if (!in_tree[v]) {
+                    return;
+                }
+                auto last = v;
+                for (auto x = next[v]; depth[x] > depth[v]; x = next[x]) {
+                    in_tree[x] = false;
+                    last = x;
+                }
+                next[prev[v]] = next[last];
+                prev[next[last]] = prev[v];
+                in_tree[v] = false;
+            }
+
+            /** @brief add v (which isn't in the tree) as a child of u */
+            void attach(vertex_t v, vertex_t u) {
+                assert(!in_tree[v] && in_tree[u]);
+                next[v] = next[u];
+                prev[v] = u;
+                prev[next[u]] = v;
+                next[u] = v;
+                depth[v] = depth[u] + 1;
+                in_tree[v] = true;
+            }
+
+            /** @brief move the subtree of v under the root */
+            void move_to_root(vertex_t v) {
+                if (!in_tree[v] || depth[v] == 1) {
+                    return;
+                }
+                auto last = get_last(v);
+                auto shift = depth[v] - 1;
+                for (auto x = v;; x = next[x]) {
+                    depth[x] -= shift;
+                    if (x == last) {
+                        break;
+                    }
+                }
+                next[prev[v]] = next[last];
+                prev[next[last]] = prev[v];
+                next[last] = next[root];
+                prev[next[root]] = last;
+                next[root] = v;
+                prev[v] = root;
+            }
+
+            const vertex_t root;
+            std::vector<vertex_t> next;
+            std::vector<vertex_t> prev;
+            std::vector<vertex_t> depth;
+            std::vector<bool> in_tree;
+        };
+
+        /** @brief rotate a cycle so it starts at its lowest vertex, and close it */
+        inline std::vector<vertex_t> canonical_cycle(std::vector<vertex_t>&& cycle) {
+            std::ranges::rotate(cycle, std::ranges::min_element(cycle));
+            cycle.push_back(cycle.front());
+            return std::move(cycle);
+        }
+
+        inline std::uint64_t edge_key(vertex_t u, vertex_t v) { return (static_cast<std::uint64_t>(u) << 32) | v; }
+
+        /**
+         * @brief The state of the negative cycles detection from a virtual source linked to all the vertices
+         * @details this is the queue-based Bellman-Ford algorithm with Tarjan's subtree disassembly. The
+         * edges of the shortest path tree are tight (d[v] == d[u] + w), so when a relaxation u -> v finds u
+         * in the subtree of v, v -> ... -> u -> v is a negative cycle. Its closing edge u -> v is then
+         * removed, so the distances are a feasible potential of the remaining edges once the queue is empty.
+         */
+        template <typename weight_t>
+        struct NegativeCycleSearch {
+            struct Cycle {
+                std::vector<vertex_t> vertices;
+                vertex_t start;
+                vertex_t end;
+            };
+
+            explicit NegativeCycleSearch(vertex_t n)
+                : distances(n, 0)
+                , predecessors(n, NO_PREDECESSOR)
+                , is_queued(n, true)
+                , tree(n) {
+                for (vertex_t v = 0; v < n; ++v) {
+                    queue.push(v);
+                }
+            }
+
+            bool is_removed(vertex_t u, vertex_t v) const {
+                return !removed_edges.empty() && removed_edges.contains(edge_key(u, v));
+            }
+
+            /** @brief relax the edge u -> v, or report the negative cycle it closes */
+            void relax(vertex_t u, vertex_t v, weight_t weight) {
+                auto new_d = distances[u] + weight;
+                if (!(new_d < distances[v]) || !tree.in_tree[u] || is_removed(u, v)) {
+                    return;
+                }
+                if (tree.is_in_subtree(u, v)) {
+                    std::vector<vertex_t> cycle;
+                    for (auto x = u; x != v; x = predecessors[x]) {
+                        cycle.push_back(x);
+                    }
+                    cycle.push_back(v);
+                    std::ranges::reverse(cycle);
+                    found.push_back({canonical_cycle(std::move(cycle)), u, v});
+                    removed_edges.insert(edge_key(u, v));
+                    return;
+                }
+                tree.remove_subtree(v);
+                distances[v] = new_d;
+                predecessors[v] = u;
+                tree.attach(v, u);
+                if (!is_queued[v]) {
+                    queue.push(v);
+                    is_queued[v] = true;
+                }
+            }
+
+            /** @brief the edge u -> v is no longer tight: its subtree is moved under the virtual source */
+            void cut(vertex_t u, vertex_t v) {
+                if (predecessors[v] == u) {
+                    tree.move_to_root(v);
+                    predecessors[v] = NO_PREDECESSOR;
+                }
+            }
+
+            template <typename G>
+            void run(const G& graph) {
+                while (!queue.empty()) {
+                    auto u = queue.front();
+                    queue.pop();
+                    is_queued[u] = false;
+                    // the distance of a vertex removed from the tree is stale: it will be reached again
+                    if (!tree.in_tree[u]) {
+                        continue;
+                    }
+                    for_each_neighbor(graph, u, [&](const auto& edge) { relax(u, edge.end, edge.weight); });
+                }
+            }
+
+            std::vector<weight_t> distances;
+            std::vector<vertex_t> predecessors;
+            std::vector<bool> is_queued;
+            std::queue<vertex_t> queue;
+            ShortestPathTree tree;
+            // the closing edges of the cycles found
+            std::unordered_set<std::uint64_t> removed_edges;
+            std::vector<Cycle> found;
+        };
+    } // namespace internal
+
+    /**
+     * @brief Find the negative cycles of a graph in a single pass
+     * @remark this is the queue-based Bellman-Ford algorithm from a virtual source linked to all the
+     * vertices, with Tarjan's subtree disassembly: when the distance of a vertex v decreases, its subtree
+     * in the shortest path tree is removed, and if it contains the start u of the relaxed edge, u -> v
+     * closes a negative cycle. This cycle is reported and its closing edge is ignored from then on.
+     * @remark Any negative cycle of the graph contains the closing edge of a returned cycle, so there is
+     * no negative cycle left if all the returned cycles are broken. However, the number of negative cycles
+     * can be exponential, so they are not all returned.
+     * @return the distinct negative cycles. Each cycle starts and ends with its lowest vertex
+     * (e.g. {1, 3, 2, 1})
+     */
+    template <typename G>
+        requires GraphImpl<G, typename G::weight_lt>
+    std::vector<std::vector<vertex_t>> find_negative_cycles(const G& graph) {
+        if (!graph.is_directed()) {
+            throw std::runtime_error("Bellman-Ford algorithm only works with directed graphs");
+        }
+
+        const auto n = static_cast<vertex_t>(graph.size());
+        std::vector<std::vector<vertex_t>> cycles;
+        // for_each_neighbor() skips the self loops
+        for (vertex_t v = 0; v < n; ++v) {
+            if (graph.weight(v, v) < 0) {
+                cycles.push_back({v, v});
+            }
+        }
+
+        internal::NegativeCycleSearch<typename G::weight_lt> search(n);
+        search.run(graph);
+        for (auto& cycle : search.found) {
+            cycles.push_back(std::move(cycle.vertices));
+        }
+        return cycles;
+    }
+
+    /**
+     * @brief Keep track of the negative cycles of a graph whose weights are updated
+     * @details The monitor owns a copy of the graph and keeps the state of find_negative_cycles(): a
+     * feasible potential of the edges which don't close a reported cycle, and a shortest path tree whose
+     * edges are tight. After a batch of set_edge(), update() only re-relaxes the updated edges and what
+     * they improve:
+     * - a reported cycle whose weight isn't negative anymore is dissolved and its closing edge is restored
+     * - a lower weight (or a new edge) is relaxed, which can form new cycles
+     * - a higher weight (or a removed edge) keeps the potential feasible, only the subtree of the end
+     *   vertex is moved under the virtual source if the edge was in the tree
+     *
+     * So the work is proportional to the region affected by the updates, not to the graph size.
+     * @remark as for find_negative_cycles(), each negative cycle of the graph goes through an edge of
+     * a reported cycle
+     */
+    template <typename G>
+        requires GraphImpl<G, typename G::weight_lt>
+    class NegativeCycleMonitor {
+       public:
+        using weight_lt = typename G::weight_lt;
+        using cycle_t = std::vector<vertex_t>;
+
+        /** @brief The cycles formed or dissolved by a batch of updates */
+        struct Changes {
+            std::vector<cycle_t> formed;
+            std::vector<cycle_t> dissolved;
+        };
+
+        /** @brief copy the graph and find its negative cycles */
+        explicit NegativeCycleMonitor(G graph)
+            : _graph(std::move(graph))
+            , _search(static_cast<vertex_t>(_graph.size())) {
+            if (!_graph.is_directed()) {
+                throw std::runtime_error("Bellman-Ford algorithm only works with directed graphs");
+            }
+            for (vertex_t v = 0; v < _graph.size(); ++v) {
+                if (_graph.weight(v, v) < 0) {
+                    add_cycle({v, v}, v, v);
+                }
+            }
+            _search.run(_graph);
+            for (auto& cycle : _search.found) {
+                add_cycle(std::move(cycle.vertices), cycle.start, cycle.end);
+            }
+            _search.found.clear();
+        }
+
+        /** @brief update the weight of an edge (0 removes it). It is taken into account by update() */
+        void set_edge(vertex_t start, vertex_t end, weight_lt weight) {
+            assert(start < _graph.size() && end < _graph.size());
+            _updates.push_back({start, end, _graph.weight(start, end)});
+            _graph.set_edge(start, end, weight);
+        }
+
+        template <std::ranges::input_range R>
+        void set_edges(R&& edges) {
+            for (const auto& edge : edges) {
+                set_edge(edge.start, edge.end, edge.weight);
+            }
+        }
+
+        /** @brief process the pending updates */
+        Changes update() {
+            Changes changes;
+            // the reported cycles going through an updated edge
+            std::unordered_set<std::uint64_t> candidates;
+            for (const auto& [u, v, old_weight] : _updates) {
+                if (auto it = _cycles_of_edge.find(internal::edge_key(u, v)); it != _cycles_of_edge.end()) {
+                    candidates.insert(it->second.begin(), it->second.end());
+                }
+            }
+            // the closing edges of the dissolved cycles are restored
+            std::vector<std::tuple<vertex_t, vertex_t>> restored;
+            for (auto key : candidates) {
+                auto it = _cycles.find(key);
+                if (it != _cycles.end() && !is_negative(it->second)) {
+                    if (it->second.start != it->second.end) {
+                        restored.push_back({it->second.start, it->second.end});
+                    }
+                    changes.dissolved.push_back(remove_cycle(it));
+                }
+            }
+
+            for (const auto& [u, v, old_weight] : _updates) {
+                auto has_edge = _graph.has_edge(u, v);
+                auto weight = _graph.weight(u, v);
+                if (u == v) {
+                    if (has_edge && weight < 0 && !_cycles.contains(internal::edge_key(v, v))) {
+                        changes.formed.push_back(add_cycle({v, v}, v, v));
+                    }
+                    continue;
+                }
+                if (!has_edge || old_weight < weight) {
+                    _search.cut(u, v);
+                }
+            }
+            // NB: the edges are relaxed once all the tree edges which are not tight anymore are cut
+            for (const auto& [u, v, old_weight] : _updates) {
+                restored.push_back({u, v});
+            }
+            for (const auto& [u, v] : restored) {
+                if (u != v && _graph.has_edge(u, v)) {
+                    _search.relax(u, v, _graph.weight(u, v));
+                }
+            }
+            _updates.clear();
+
+            _search.run(_graph);
+            for (auto& cycle : _search.found) {
+                changes.formed.push_back(add_cycle(std::move(cycle.vertices), cycle.start, cycle.end));
+            }
+            _search.found.clear();
+            return changes;
+        }
+
+        /** @brief the current negative cycles. Each cycle starts and ends with its lowest vertex */
+        generator<cycle_t> get_cycles() const {
+            for (const auto& [key, cycle] : _cycles) {
+                co_yield cycle.vertices;
+            }
+        }
+
+        auto n_cycles() const { return _cycles.size(); }
+
+        const G& graph() const { return _graph; }
+
+       private:
+        struct Cycle {
+            cycle_t vertices;
+            vertex_t start;
+            vertex_t end;
+        };
+
+        bool is_negative(const Cycle& cycle) const {
+            weight_lt weight = 0;
+            for (std::size_t i = 0; i + 1 < cycle.vertices.size(); ++i) {
+                if (!_graph.has_edge(cycle.vertices[i], cycle.vertices[i + 1])) {
+                    return false;
+                }
+                weight += _graph.weight(cycle.vertices[i], cycle.vertices[i + 1]);
+            }
+            return weight < 0;
+        }
+
+        const cycle_t& add_cycle(cycle_t&& vertices, vertex_t start, vertex_t end) {
+            auto key = internal::edge_key(start, end);
+            for (std::size_t i = 0; i + 1 < vertices.size(); ++i) {
+                _cycles_of_edge[internal::edge_key(vertices[i], vertices[i + 1])].insert(key);
+            }
+            auto [it, inserted] = _cycles.emplace(key, Cycle{std::move(vertices), start, end});
+            assert(inserted);
+            return it->second.vertices;
+        }
+
+        cycle_t remove_cycle(typename std::unordered_map<std::uint64_t, Cycle>::iterator it) {
+            auto key = it->first;
+            auto cycle = std::move(it->second);
+            _cycles.erase(it);
+            for (std::size_t i = 0; i + 1 < cycle.vertices.size(); ++i) {
+                auto edge = _cycles_of_edge.find(internal::edge_key(cycle.vertices[i], cycle.vertices[i + 1]));
+                edge->second.erase(key);
+                if (edge->second.empty()) {
+                    _cycles_of_edge.erase(edge);
+                }
+            }
+            _search.removed_edges.erase(key);
+            return std::move(cycle.vertices);
+        }
+
+        G _graph;
+        internal::NegativeCycleSearch<weight_lt> _search;
+        // the reported cycles by closing edge
+        std::unordered_map<std::uint64_t, Cycle> _cycles;
+        // the reported cycles going through each edge
+        std::unordered_map<std::uint64_t, std::unordered_set<std::uint64_t>> _cycles_of_edge;
+        // the updated edges with their previous weight
+        std::vector<std::tuple<vertex_t, vertex_t, weight_lt>> _updates;
+    };
 }  // namespace grafology
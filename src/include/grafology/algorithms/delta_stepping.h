@@ -0,0 +1,384 @@
+#pragma once
+#include "all_shortest_paths.h"
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <thread>
+#include <vector>
+
+namespace grafology {
+    namespace internal {
+        /**
+         * @brief The state shared by the threads of the delta-stepping algorithm
+         * @details Each vertex is owned by one thread, which is the only one allowed to write its
+         * distance, predecessor and bucket. The other threads send it relaxation requests.
+         * The vertices are distributed by blocks of 64 to avoid false sharing.
+         */
+        template <typename weight_t>
+        struct DeltaStepping {
+            static constexpr std::size_t NO_BUCKET = std::numeric_limits<std::size_t>::max();
+            static constexpr vertex_t BLOCK_SIZE = 64;
+            // the maximum number of buckets of the circular array of each thread
+            static constexpr std::size_t MAX_BUCKETS = 1 << 16;
+
+            struct Request {
+                vertex_t vertex;
+                weight_t distance;
+                vertex_t predecessor;
+            };
+
+            struct OverflowEntry {
+                vertex_t vertex;
+                std::size_t bucket;
+            };
+
+            /** @brief the data of a thread */
+            struct Worker {
+                // the buckets are circular: they hold the buckets [window_start, window_start + n_buckets)
+                std::vector<std::vector<vertex_t>> buckets;
+                std::size_t window_start = 0;
+                // the vertices whose bucket is after the window, moved to the buckets when the window moves
+                std::vector<OverflowEntry> overflow;
+                // the vertices of the current bucket which are processed
+                std::vector<vertex_t> frontier;
+                // the vertices removed from the current bucket, for relaxing the heavy edges
+                std::vector<vertex_t> settled;
+                // the requests sent to each thread
+                std::vector<std::vector<Request>> requests;
+                // the statistics of the edges starting at the vertices owned by the thread
+                weight_t max_weight = 0;
+                std::size_t n_edges = 0;
+                bool has_negative_weight = false;
+            };
+
+            DeltaStepping(AllShortestPathsImpl<weight_t>& res, weight_t delta, unsigned n_threads)
+                : res(res)
+                , delta(delta)
+                , n_threads(n_threads)
+                , bucket_of_vertex(res.size(), NO_BUCKET)
+                , is_settled(res.size(), false)
+                , workers(n_threads)
+                , frontier_sizes(n_threads, 0)
+                , overflow_minimums(n_threads, NO_BUCKET)
+                , sync(n_threads) {
+                for (auto& worker : workers) {
+                    worker.requests.resize(n_threads);
+                }
+            }
+
+            unsigned owner(vertex_t v) const { return (v / BLOCK_SIZE) % n_threads; }
+
+            std::size_t get_bucket(weight_t d) const { return static_cast<std::size_t>(d / delta); }
+
+            /**
+             * @brief the distance of a vertex, which can be read by any thread for filtering the requests
+             * but is only written by the owner of the vertex
+             */
+            std::atomic_ref<weight_t> distance_of(vertex_t v) const { return std::atomic_ref<weight_t>(res._distances[v]); }
+
+            /** @brief update a vertex owned by the thread t. For equal distances, the lowest predecessor wins */
+            void relax(unsigned t, const Request& request) {
+                auto v = request.vertex;
+                auto distance = res._distances[v];
+                if (request.distance < distance) {
+                    distance_of(v).store(request.distance, std::memory_order_relaxed);
+                    res._predecessors[v] = request.predecessor;
+                    auto b = get_bucket(request.distance);
+                    if (bucket_of_vertex[v] != b) {
+                        bucket_of_vertex[v] = b;
+                        auto& worker = workers[t];
+                        if (b < worker.window_start + n_buckets) {
+                            worker.buckets[b % n_buckets].push_back(v);
+                        } else {
+                            worker.overflow.push_back({v, b});
+                        }
+                    }
+                } else if (request.distance == distance && request.predecessor < res._predecessors[v]) {
+                    res._predecessors[v] = request.predecessor;
+                }
+            }
+
+            /** @brief the next non empty bucket of the window (from any thread) starting at current, or NO_BUCKET */
+            std::size_t find_next_bucket(std::size_t current, std::size_t window_start) const {
+                for (std::size_t b = current; b < window_start + n_buckets; ++b) {
+                    for (const auto& worker : workers) {
+                        if (!worker.buckets[b % n_buckets].empty()) {
+                            return b;
+                        }
+                    }
+                }
+                return NO_BUCKET;
+            }
+
+            /** @brief move the vertices of the bucket b owned by t to its frontier (skipping the stale entries) */
+            void take_bucket(unsigned t, std::size_t b) {
+                auto& worker = workers[t];
+                auto& bucket = worker.buckets[b % n_buckets];
+                worker.frontier.clear();
+                for (auto v : bucket) {
+                    // the vertex may have moved to a lower bucket since it was pushed
+                    if (bucket_of_vertex[v] == b) {
+                        bucket_of_vertex[v] = NO_BUCKET;
+                        worker.frontier.push_back(v);
+                        if (!is_settled[v]) {
+                            is_settled[v] = true;
+                            worker.settled.push_back(v);
+                        }
+                    }
+                }
+                bucket.clear();
+                frontier_sizes[t] = worker.frontier.size();
+            }
+
+            /** @brief drop the stale overflow entries of t and return their lowest bucket, or NO_BUCKET */
+            std::size_t compact_overflow(unsigned t) {
+                auto& overflow = workers[t].overflow;
+                std::erase_if(overflow, [&](const auto& entry) { return bucket_of_vertex[entry.vertex] != entry.bucket; });
+                auto lowest = std::ranges::min_element(overflow, {}, &OverflowEntry::bucket);
+                return lowest == overflow.end() ? NO_BUCKET : lowest->bucket;
+            }
+
+            /** @brief move the window of t and its overflow entries which are now in the window to the buckets */
+            void move_window(unsigned t, std::size_t window_start) {
+                auto& worker = workers[t];
+                worker.window_start = window_start;
+                std::erase_if(worker.overflow, [&](const auto& entry) {
+                    if (entry.bucket < window_start + n_buckets) {
+                        worker.buckets[entry.bucket % n_buckets].push_back(entry.vertex);
+                        return true;
+                    }
+                    return false;
+                });
+            }
+
+            template <typename G>
+            void send_requests(unsigned t, const G& graph, const std::vector<vertex_t>& vertices, bool light) {
+                auto& worker = workers[t];
+                for (auto u : vertices) {
+                    auto d = res._distances[u];
+                    for_each_neighbor(graph, u, [&](const auto& edge) {
+                        if ((edge.weight <= delta) == light) {
+                            auto new_d = d + edge.weight;
+                            // the distance may be stale, but it can only be larger than the current one
+                            if (!(distance_of(edge.end).load(std::memory_order_relaxed) < new_d)) {
+                                worker.requests[owner(edge.end)].push_back({edge.end, new_d, u});
+                            }
+                        }
+                    });
+                }
+            }
+
+            void process_requests(unsigned t) {
+                for (auto& worker : workers) {
+                    for (const auto& request : worker.requests[t]) {
+                        relax(t, request);
+                    }
+                    worker.requests[t].clear();
+                }
+            }
+
+            /**
+             * @brief check the weights of the edges of the vertices owned by t, and compute their maximum
+             * weight and their number if delta must be chosen
+             */
+            template <typename G>
+            void scan_edges(unsigned t, const G& graph) {
+                const auto n_vertices = graph.size();
+                const bool with_statistics = delta == 0;
+                weight_t max_weight = 0;
+                std::size_t n_edges = 0;
+                bool has_negative_weight = false;
+                for (vertex_t first = t * BLOCK_SIZE; first < n_vertices; first += n_threads * BLOCK_SIZE) {
+                    for (vertex_t v = first; v < std::min(first + BLOCK_SIZE, n_vertices); ++v) {
+                        if (with_statistics) {
+                            for_each_neighbor(graph, v, [&](const auto& edge) {
+                                has_negative_weight |= edge.weight < 0;
+                                max_weight = std::max(max_weight, edge.weight);
+                                ++n_edges;
+                            });
+                        } else {
+                            for_each_neighbor(graph, v, [&](const auto& edge) { has_negative_weight |= edge.weight < 0; });
+                        }
+                    }
+                }
+                auto& worker = workers[t];
+                worker.max_weight = max_weight;
+                worker.n_edges = n_edges;
+                worker.has_negative_weight = has_negative_weight;
+            }
+
+            /** @brief set delta (if it is 0) and the number of buckets from the statistics of the edges */
+            void set_delta() {
+                weight_t max_weight = 0;
+                std::size_t n_edges = 0;
+                for (const auto& worker : workers) {
+                    has_negative_weight |= worker.has_negative_weight;
+                    max_weight = std::max(max_weight, worker.max_weight);
+                    n_edges += worker.n_edges;
+                }
+                // the live vertices are in the buckets [current, current + max_weight/delta]. The array is
+                // bounded as a small delta would need too many buckets: the farther vertices overflow.
+                const auto max_buckets = std::min<std::size_t>(res.size(), MAX_BUCKETS) + 2;
+                if (delta != 0) {
+                    // the edges have not been scanned, so max_weight is unknown
+                    n_buckets = max_buckets;
+                    return;
+                }
+                // a bucket holds about one edge per vertex
+                auto average_degree = std::max<std::size_t>(1, n_edges / std::max<std::size_t>(1, res.size()));
+                delta = max_weight / static_cast<weight_t>(average_degree);
+                if constexpr (std::integral<weight_t>) {
+                    delta = std::max<weight_t>(delta, 1);
+                } else if (!(delta > 0)) {
+                    delta = max_weight > 0 ? max_weight : 1;
+                }
+                n_buckets = std::min(static_cast<std::size_t>(std::min<weight_t>(max_weight / delta, max_buckets)) + 2, max_buckets);
+            }
+
+            /** @brief the loop run by each thread. All the threads take the same decisions from the shared state */
+            template <typename G>
+            void run(unsigned t, const G& graph, vertex_t start) {
+                auto& worker = workers[t];
+                // the edges are scanned in parallel for choosing delta and the number of buckets
+                scan_edges(t, graph);
+                sync.arrive_and_wait();
+                if (t == 0) {
+                    set_delta();
+                }
+                sync.arrive_and_wait();
+                if (has_negative_weight) {
+                    return;
+                }
+                worker.buckets.resize(n_buckets);
+                if (owner(start) == t) {
+                    relax(t, {start, 0, NO_PREDECESSOR});
+                }
+
+                std::size_t current = 0;
+                while (true) {
+                    sync.arrive_and_wait();
+                    current = find_next_bucket(current, worker.window_start);
+                    // the buckets must not be modified until all the threads have found the next one
+                    sync.arrive_and_wait();
+                    if (current == NO_BUCKET) {
+                        // the window is empty: it moves to the lowest bucket of the overflowing vertices
+                        overflow_minimums[t] = compact_overflow(t);
+                        sync.arrive_and_wait();
+                        current = std::ranges::min(overflow_minimums);
+                        if (current == NO_BUCKET) {
+                            break;
+                        }
+                        move_window(t, current);
+                        continue;
+                    }
+                    // the light edges can add vertices to the current bucket, so it is processed until it is empty
+                    while (true) {
+                        take_bucket(t, current);
+                        sync.arrive_and_wait();
+                        std::size_t total = 0;
+                        for (auto size : frontier_sizes) {
+                            total += size;
+                        }
+                        if (total == 0) {
+                            break;
+                        }
+                        send_requests(t, graph, worker.frontier, true);
+                        sync.arrive_and_wait();
+                        // NB: the next barrier is passed only once all the requests are processed
+                        // and all the frontier sizes have been read
+                        process_requests(t);
+                    }
+                    // the heavy edges can't add vertices to the current bucket: they are relaxed once
+                    send_requests(t, graph, worker.settled, false);
+                    for (auto v : worker.settled) {
+                        is_settled[v] = false;
+                    }
+                    worker.settled.clear();
+                    sync.arrive_and_wait();
+                    process_requests(t);
+                }
+            }
+
+            AllShortestPathsImpl<weight_t>& res;
+            weight_t delta;
+            std::size_t n_buckets = 0;
+            bool has_negative_weight = false;
+            const unsigned n_threads;
+            // the bucket in which each vertex is queued (only written by the owner of the vertex)
+            std::vector<std::size_t> bucket_of_vertex;
+            // NB: a vector<char> and not a vector<bool> as each thread writes the flags of its own vertices
+            std::vector<char> is_settled;
+            std::vector<Worker> workers;
+            std::vector<std::size_t> frontier_sizes;
+            // the lowest bucket of the overflowing vertices of each thread
+            std::vector<std::size_t> overflow_minimums;
+            std::barrier<> sync;
+        };
+    } // namespace internal
+
+    /**
+     * @brief Compute the shortest paths from a vertex to all other vertices in a graph with several threads
+     * @remark this is based on the delta-stepping algorithm: the vertices are put in buckets of width delta
+     * (by distance). The vertices of the lowest bucket are processed in parallel: first the light edges
+     * (weight <= delta), which can add vertices to the current bucket, until the bucket is empty, then
+     * the heavy edges once. Each thread keeps a bounded circular array of buckets: the vertices which are
+     * too far from the current bucket wait in an overflow list until the array reaches them.
+     * @param delta the width of the buckets. A small delta does less redundant work but has less
+     * parallelism (with a delta lower than the minimum weight, it is Dijkstra's algorithm). If it is 0, the
+     * maximum weight divided by the average degree is used.
+     * @param n_threads the number of threads (0 for the hardware concurrency)
+     * @return the same result as all_shortest_paths(). When several shortest paths exist, the predecessor
+     * is the lowest vertex, so the result doesn't depend on the number of threads.
+     * @throw error if a weight is negative or if delta is negative
+     */
+    template <typename G>
+        requires GraphImpl<G, typename G::weight_lt>
+    AllShortestPathsImpl<typename G::weight_lt> all_shortest_paths_delta_stepping(
+        const G& graph,
+        vertex_t start,
+        typename G::weight_lt delta = 0,
+        unsigned n_threads = 0
+    ) {
+        using weight_lt = typename G::weight_lt;
+        assert(start < graph.size());
+
+        if (delta < 0) {
+            throw error("Delta-stepping: delta must be positive");
+        }
+        if (n_threads == 0) {
+            n_threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        AllShortestPathsImpl<weight_lt> res(graph.size(), start);
+        internal::DeltaStepping<weight_lt> state(res, delta, n_threads);
+        {
+            std::vector<std::jthread> threads;
+            threads.reserve(n_threads - 1);
+            for (unsigned t = 1; t < n_threads; ++t) {
+                threads.emplace_back([&state, &graph, t, start] { state.run(t, graph, start); });
+            }
+            state.run(0, graph, start);
+        }
+        if (state.has_negative_weight) {
+            throw error("Delta-stepping: negative weights are not allowed");
+        }
+        return res;
+    }
+
+    /**
+     * @brief Compute the shortest paths from a vertex to all other vertices in a graph with several threads
+     * @see all_shortest_paths_delta_stepping(const G&, vertex_t, typename G::weight_lt, unsigned)
+     */
+    template <typename Impl, VertexKey Vertex, bool directed>
+        requires GraphImpl<Impl, typename Impl::weight_lt>
+    AllShortestPaths<Impl, Vertex, directed> all_shortest_paths_delta_stepping(
+        const Graph<Impl, Vertex, directed, typename Impl::weight_lt>& graph,
+        const Vertex& start,
+        typename Impl::weight_lt delta = 0,
+        unsigned n_threads = 0
+    ) {
+        assert(graph.get_internal_index(start) != INVALID_VERTEX);
+        auto sp_impl = all_shortest_paths_delta_stepping(graph.impl(), graph.get_internal_index(start), delta, n_threads);
+        return AllShortestPaths<Impl, Vertex, directed>(std::move(sp_impl), graph);
+    }
+} // namespace grafology
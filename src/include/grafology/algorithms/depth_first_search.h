@@ -22,9 +22,9 @@ namespace grafology {
             if (!visited[current]) {
                 visited[current] = true;
                 co_yield current;
-                for (auto neighbour : graph.get_raw_neighbors(current)) {
-                    stack.push(neighbour);
-                }
+                for_each_neighbor(graph, current, [&](const auto& edge) {
+                    stack.push(edge.end);
+                });
             }
         }
     }
@@ -55,24 +55,24 @@ namespace grafology {
                 _visited.assign(_graph.size(), false);
                 _parent.assign(_graph.size(), NO_PREDECESSOR);
 
+                bool found = false;
                 stack.push(_start);
-                while (!stack.empty()) {
+                while (!stack.empty() && !found) {
                     vertex_t current = stack.top();
                     stack.pop();
                     if (!_visited[current]) {
                         _visited[current] = true;
-                        for (auto neighbour : _graph.get_raw_neighbors(current)) {
-                            if (!_visited[neighbour]) {
+                        for_each_neighbor(_graph, current, [&](const auto& edge) {
+                            auto neighbour = edge.end;
+                            if (!found && !_visited[neighbour]) {
                                 stack.push(neighbour);
                                 _parent[neighbour] = current;
-                                if (neighbour == _end) {
-                                    return true;
-                                }
+                                found = neighbour == _end;
                             }
-                        }
+                        });
                     }
                 }
-                return false;
+                return found;
             }
 
             generator<vertex_t> get_path() {
@@ -0,0 +1,350 @@
+#pragma once
+#include "all_shortest_paths.h"
+#include <algorithm>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace grafology {
+    /**
+     * @brief The strategies for selecting the landmarks
+     * - Farthest: each landmark is the vertex the farthest from the landmarks already selected
+     * - Avoid: each landmark is chosen in the regions where the current landmarks give the worst estimations
+     */
+    enum class LandmarkSelection { Farthest, Avoid };
+
+    //==============================================================================
+    // Implementation Graphs
+    //==============================================================================
+
+    /**
+     * @brief A cost function for the A* algorithm computed from the distances to a few landmarks (ALT)
+     * @details For a landmark L, the triangle inequality gives two lower bounds of the distance from u to v:
+     * - d(L, v) - d(L, u)
+     * - d(u, L) - d(v, L)
+     *
+     * The estimation is the highest of these bounds over all the landmarks. It never overestimates the
+     * distance and is consistent, so it can be used by shortest_path() and bidirectional_shortest_path().
+     * When the landmarks show that v can't be reached from u, D_INFINITY is returned.
+     * @remark the distances are stored by vertex (the distances of a vertex to all the landmarks are
+     * contiguous). For undirected graphs, d(L, v) = d(v, L) so only one table is stored.
+     */
+    template <typename weight_t>
+    class LandmarkHeuristicImpl {
+        static constexpr auto D_INFINITY = edge_t<weight_t>::D_INFINITY;
+
+    public:
+        LandmarkHeuristicImpl(std::size_t n_vertices, bool is_directed)
+            : _n_vertices(n_vertices)
+            , _is_directed(is_directed) {}
+
+        auto size() const { return _n_vertices; }
+
+        const std::vector<vertex_t>& get_landmarks() const { return _landmarks; }
+
+        /** @brief the memory used by the distance tables (in bytes) */
+        std::size_t memory_size() const {
+            return (_from_landmarks.size() + _to_landmarks.size()) * sizeof(weight_t);
+        }
+
+        /** @brief a lower bound of the distance from u to v */
+        weight_t operator()(vertex_t u, vertex_t v) const {
+            assert(u < _n_vertices && v < _n_vertices);
+            const auto from_u = get_from_landmarks(u);
+            const auto from_v = get_from_landmarks(v);
+            const auto to_u = get_to_landmarks(u);
+            const auto to_v = get_to_landmarks(v);
+            weight_t res = 0;
+            for (std::size_t i = 0; i < _landmarks.size(); ++i) {
+                // d(L, v) <= d(L, u) + d(u, v)
+                if (from_u[i] != D_INFINITY) {
+                    if (from_v[i] == D_INFINITY) {
+                        return D_INFINITY;
+                    }
+                    if (from_u[i] < from_v[i]) {
+                        res = std::max(res, from_v[i] - from_u[i]);
+                    }
+                }
+                // d(u, L) <= d(u, v) + d(v, L)
+                if (to_v[i] != D_INFINITY) {
+                    if (to_u[i] == D_INFINITY) {
+                        return D_INFINITY;
+                    }
+                    if (to_v[i] < to_u[i]) {
+                        res = std::max(res, to_u[i] - to_v[i]);
+                    }
+                }
+            }
+            return res;
+        }
+
+        /**
+         * @brief add a landmark and compute the distances from it and to it
+         * @param inverted the inverted graph, for the distances to the landmark (not used for undirected graphs)
+         */
+        template <typename G>
+            requires GraphImpl<G, weight_t>
+        void add_landmark(const G& graph, const G& inverted, vertex_t landmark) {
+            assert(landmark < _n_vertices);
+            auto from = all_shortest_paths(graph, landmark);
+            insert_column(_from_landmarks, from._distances);
+            if (_is_directed) {
+                auto to = all_shortest_paths(inverted, landmark);
+                insert_column(_to_landmarks, to._distances);
+            }
+            _landmarks.push_back(landmark);
+        }
+
+        /** @brief the distances from the landmarks to v */
+        std::span<const weight_t> get_from_landmarks(vertex_t v) const {
+            return {_from_landmarks.data() + v * _landmarks.size(), _landmarks.size()};
+        }
+
+        /** @brief the distances from v to the landmarks */
+        std::span<const weight_t> get_to_landmarks(vertex_t v) const {
+            const auto& table = _is_directed ? _to_landmarks : _from_landmarks;
+            return {table.data() + v * _landmarks.size(), _landmarks.size()};
+        }
+
+    private:
+        /** @brief append the distances of a new landmark to the table (n_vertices x n_landmarks) */
+        void insert_column(std::vector<weight_t>& table, const std::vector<weight_t>& distances) const {
+            const auto n_landmarks = _landmarks.size();
+            std::vector<weight_t> res;
+            res.reserve(_n_vertices * (n_landmarks + 1));
+            for (vertex_t v = 0; v < _n_vertices; ++v) {
+                res.insert(res.end(), table.begin() + v * n_landmarks, table.begin() + (v + 1) * n_landmarks);
+                res.push_back(distances[v]);
+            }
+            table = std::move(res);
+        }
+
+        std::size_t _n_vertices;
+        bool _is_directed;
+        std::vector<vertex_t> _landmarks;
+        std::vector<weight_t> _from_landmarks;
+        std::vector<weight_t> _to_landmarks;
+    };
+
+    namespace internal {
+        /**
+         * @brief the vertex the farthest from the landmarks (the lowest distance to a landmark is maximised)
+         * @remark the vertices which aren't connected to the landmarks are only chosen when they are the
+         * majority (or when all the others are landmarks): a landmark in a small component would be useless
+         * for most of the queries
+         * @return INVALID_VERTEX if all the vertices are at a distance 0 from the landmarks
+         */
+        template <typename weight_t>
+        vertex_t get_farthest_vertex(const LandmarkHeuristicImpl<weight_t>& heuristic) {
+            static constexpr auto D_INFINITY = edge_t<weight_t>::D_INFINITY;
+            vertex_t res = INVALID_VERTEX;
+            weight_t best_distance = 0;
+            vertex_t not_connected = INVALID_VERTEX;
+            std::size_t n_connected = 0;
+            for (vertex_t v = 0; v < heuristic.size(); ++v) {
+                const auto from = heuristic.get_from_landmarks(v);
+                const auto to = heuristic.get_to_landmarks(v);
+                auto distance = D_INFINITY;
+                for (std::size_t i = 0; i < from.size(); ++i) {
+                    distance = std::min({distance, from[i], to[i]});
+                }
+                if (distance == D_INFINITY) {
+                    if (not_connected == INVALID_VERTEX) {
+                        not_connected = v;
+                    }
+                    continue;
+                }
+                ++n_connected;
+                if (best_distance < distance) {
+                    best_distance = distance;
+                    res = v;
+                }
+            }
+            if (not_connected != INVALID_VERTEX && (res == INVALID_VERTEX || 2 * n_connected < heuristic.size())) {
+                return not_connected;
+            }
+            return res;
+        }
+
+        /**
+         * @brief the next landmark with the avoid strategy
+         * @details A shortest path tree is grown from a root. The weight of a vertex is the error of the
+         * current estimation of its distance from the root, and the size of a vertex is the sum of the
+         * weights of its subtree (0 if the subtree contains a landmark). From the vertex with the largest
+         * size, the child with the largest size is followed down to a leaf, which becomes the new landmark.
+         */
+        template <typename G>
+        vertex_t get_avoid_vertex(const G& graph, const LandmarkHeuristicImpl<typename G::weight_lt>& heuristic, vertex_t root) {
+            using weight_lt = typename G::weight_lt;
+            const auto n_vertices = graph.size();
+            auto tree = all_shortest_paths(graph, root);
+
+            // the vertices of the tree by decreasing distance: the children before their parent
+            std::vector<vertex_t> order;
+            for (vertex_t v = 0; v < n_vertices; ++v) {
+                if (tree.is_reachable(v)) {
+                    order.push_back(v);
+                }
+            }
+            std::ranges::sort(order, [&](vertex_t a, vertex_t b) { return tree._distances[b] < tree._distances[a]; });
+
+            std::vector<weight_lt> sizes(n_vertices, 0);
+            std::vector<bool> has_landmark(n_vertices, false);
+            for (auto landmark : heuristic.get_landmarks()) {
+                has_landmark[landmark] = true;
+            }
+            for (auto v : order) {
+                if (has_landmark[v]) {
+                    sizes[v] = 0;
+                } else {
+                    auto estimation = heuristic.get_landmarks().empty() ? 0 : heuristic(root, v);
+                    sizes[v] += tree._distances[v] - estimation;
+                }
+                auto parent = tree._predecessors[v];
+                if (parent != NO_PREDECESSOR) {
+                    has_landmark[parent] = has_landmark[parent] || has_landmark[v];
+                    sizes[parent] += sizes[v];
+                }
+            }
+            for (auto v : order) {
+                if (has_landmark[v]) {
+                    sizes[v] = 0;
+                }
+            }
+
+            auto best = std::ranges::max_element(order, {}, [&](vertex_t v) { return sizes[v]; });
+            if (best == order.end() || sizes[*best] == 0) {
+                return get_farthest_vertex(heuristic);
+            }
+            // the children of each vertex in the tree
+            std::vector<vertex_t> best_child(n_vertices, INVALID_VERTEX);
+            for (auto v : order) {
+                auto parent = tree._predecessors[v];
+                if (parent != NO_PREDECESSOR && (best_child[parent] == INVALID_VERTEX || sizes[best_child[parent]] < sizes[v])) {
+                    best_child[parent] = v;
+                }
+            }
+            auto res = *best;
+            while (best_child[res] != INVALID_VERTEX) {
+                res = best_child[res];
+            }
+            return res;
+        }
+    } // namespace internal
+
+    /**
+     * @brief Select landmarks and compute the distances from them and to them
+     * @param n_landmarks the number of landmarks. The memory used is n_vertices x n_landmarks distances
+     * (twice for directed graphs) and each estimation reads all of them, so a few landmarks (e.g. 8 to 16)
+     * are enough.
+     * @param selection the strategy for selecting the landmarks
+     * @return a cost function for shortest_path()
+     * @remark the selection stops when all the other vertices are at a distance 0 from the landmarks (e.g. when
+     * n_landmarks is the number of vertices), so the heuristic may have fewer landmarks than n_landmarks
+     */
+    template <typename G>
+        requires GraphImpl<G, typename G::weight_lt>
+    LandmarkHeuristicImpl<typename G::weight_lt> landmark_heuristic(
+        const G& graph,
+        unsigned n_landmarks,
+        LandmarkSelection selection = LandmarkSelection::Farthest
+    ) {
+        const auto n_vertices = graph.size();
+        LandmarkHeuristicImpl<typename G::weight_lt> res(n_vertices, graph.is_directed());
+        if (n_vertices == 0) {
+            return res;
+        }
+        std::optional<G> inverted;
+        if (graph.is_directed()) {
+            inverted.emplace(graph.invert());
+        }
+        const G& inverted_graph = inverted ? *inverted : graph;
+        n_landmarks = std::min<unsigned>(n_landmarks, n_vertices);
+
+        if (selection == LandmarkSelection::Farthest) {
+            // the first landmark is the vertex the farthest from vertex 0
+            res.add_landmark(graph, inverted_graph, 0);
+            auto first = internal::get_farthest_vertex(res);
+            if (first != INVALID_VERTEX) {
+                res = LandmarkHeuristicImpl<typename G::weight_lt>(n_vertices, graph.is_directed());
+                res.add_landmark(graph, inverted_graph, first);
+            }
+            while (res.get_landmarks().size() < n_landmarks) {
+                auto landmark = internal::get_farthest_vertex(res);
+                // all the other vertices are at a distance 0 from the landmarks
+                if (landmark == INVALID_VERTEX) {
+                    break;
+                }
+                res.add_landmark(graph, inverted_graph, landmark);
+            }
+        } else {
+            // the roots of the trees are spread over the vertices
+            for (unsigned i = 0; i < n_landmarks; ++i) {
+                auto root = static_cast<vertex_t>((i * 2654435761ull) % n_vertices);
+                auto landmark = internal::get_avoid_vertex(graph, res, root);
+                if (landmark == INVALID_VERTEX) {
+                    break;
+                }
+                res.add_landmark(graph, inverted_graph, landmark);
+            }
+        }
+        return res;
+    }
+
+    //==============================================================================
+    // Graphs
+    //==============================================================================
+
+    /**
+     * @brief A cost function for the A* algorithm computed from the distances to a few landmarks (ALT)
+     * @see LandmarkHeuristicImpl
+     */
+    template <typename Impl, VertexKey Vertex, bool IsDirected>
+        requires GraphImpl<Impl, typename Impl::weight_lt>
+    class LandmarkHeuristic {
+    public:
+        using weight_lt = typename Impl::weight_lt;
+
+        LandmarkHeuristic(
+            LandmarkHeuristicImpl<weight_lt>&& heuristic,
+            const Graph<Impl, Vertex, IsDirected, weight_lt>& graph
+        )
+            : _heuristic(std::move(heuristic))
+            , graph(graph) {}
+
+        const LandmarkHeuristicImpl<weight_lt>& impl() const { return _heuristic; }
+
+        generator<Vertex> get_landmarks() const {
+            for (auto landmark : _heuristic.get_landmarks()) {
+                co_yield graph.get_vertex_from_internal_index(landmark);
+            }
+        }
+
+        /** @brief the memory used by the distance tables (in bytes) */
+        std::size_t memory_size() const { return _heuristic.memory_size(); }
+
+        /** @brief a lower bound of the distance from u to v */
+        weight_lt operator()(const Vertex& u, const Vertex& v) const {
+            assert(graph.get_internal_index(u) != INVALID_VERTEX && graph.get_internal_index(v) != INVALID_VERTEX);
+            return _heuristic(graph.get_internal_index(u), graph.get_internal_index(v));
+        }
+
+    private:
+        LandmarkHeuristicImpl<weight_lt> _heuristic;
+        const Graph<Impl, Vertex, IsDirected, weight_lt>& graph;
+    };
+
+    /**
+     * @brief Select landmarks and compute the distances from them and to them
+     * @see landmark_heuristic(const G&, unsigned, LandmarkSelection)
+     */
+    template <typename Impl, VertexKey Vertex, bool directed>
+        requires GraphImpl<Impl, typename Impl::weight_lt>
+    LandmarkHeuristic<Impl, Vertex, directed> landmark_heuristic(
+        const Graph<Impl, Vertex, directed, typename Impl::weight_lt>& graph,
+        unsigned n_landmarks,
+        LandmarkSelection selection = LandmarkSelection::Farthest
+    ) {
+        return LandmarkHeuristic<Impl, Vertex, directed>(landmark_heuristic(graph.impl(), n_landmarks, selection), graph);
+    }
+} // namespace grafology
@@ -1,7 +1,453 @@
 #pragma once
-#include "depth_first_search.h"
+#include "../graph.h"
+#include <algorithm>
+#include <vector>
 
 namespace grafology {
+    /**
+     * @brief The result of the maximum flow algorithms
+     * @details the flows are stored as a graph of the same type as the flow network, whose weights
+     * are the flows of the edges (the edges without flow are absent)
+     */
+    template <typename G>
+    struct MaximumFlowImpl {
+        typename G::weight_lt value;
+        G flows;
+    };
+
+    namespace internal {
+        /**
+         * @brief The residual network of a flow network, in the CSR format
+         * @details each edge (u, v) of the graph gives two paired arcs: the forward arc u -> v, whose residual
+         * capacity is the capacity minus the flow, and the reverse arc v -> u, whose residual capacity is the flow.
+         * The arcs of a vertex are contiguous and reverse[arc] is the index of the paired arc, so pushing
+         * some flow along an arc is O(1), without any lookup.
+         */
+        template <typename weight_t>
+        struct ResidualNetwork {
+            template <typename G>
+            explicit ResidualNetwork(const G& graph)
+                : offsets(graph.size() + 1, 0) {
+                const auto n_vertices = graph.size();
+                for (vertex_t u = 0; u < n_vertices; ++u) {
+                    for_each_neighbor(graph, u, [&](const auto& edge) {
+                        assert(edge.weight > 0);
+                        ++offsets[u + 1];
+                        ++offsets[edge.end + 1];
+                    });
+                }
+                for (vertex_t u = 0; u < n_vertices; ++u) {
+                    offsets[u + 1] += offsets[u];
+                }
+                heads.resize(offsets.back());
+                capacities.resize(offsets.back());
+                reverse.resize(offsets.back());
+                forward_arcs.reserve(offsets.back() / 2);
+                std::vector<std::size_t> positions(offsets.begin(), offsets.end() - 1);
+                for (vertex_t u = 0; u < n_vertices; ++u) {
+                    for_each_neighbor(graph, u, [&](const auto& edge) {
+                        auto forward = positions[u]++;
+                        auto backward = positions[edge.end]++;
+                        heads[forward] = edge.end;
+                        heads[backward] = u;
+                        capacities[forward] = edge.weight;
+                        capacities[backward] = 0;
+                        reverse[forward] = backward;
+                        reverse[backward] = forward;
+                        forward_arcs.push_back(forward);
+                    });
+                }
+            }
+
+            std::size_t size() const { return offsets.size() - 1; }
+
+            vertex_t tail(std::size_t arc) const { return heads[reverse[arc]]; }
+
+            void push(std::size_t arc, weight_t flow) {
+                capacities[arc] -= flow;
+                capacities[reverse[arc]] += flow;
+            }
+
+            /** @brief the flow of each edge (the residual capacity of its reverse arc), as a graph like graph */
+            template <typename G>
+            G get_flows(const G& graph) const {
+                std::vector<edge_t<weight_t>> edges;
+                for (auto arc : forward_arcs) {
+                    auto flow = capacities[reverse[arc]];
+                    if (flow > 0) {
+                        edges.push_back({tail(arc), heads[arc], flow});
+                    }
+                }
+                G flows(graph.capacity(), graph.size(), true);
+                flows.set_edges(edges);
+                return flows;
+            }
+
+            std::vector<std::size_t> offsets;
+            std::vector<vertex_t> heads;
+            // the residual capacities
+            std::vector<weight_t> capacities;
+            std::vector<std::size_t> reverse;
+            // the forward arc of each edge of the graph
+            std::vector<std::size_t> forward_arcs;
+        };
+
+        /**
+         * @brief The Dinic's algorithm
+         * @details each phase computes the levels of the vertices (their distance from the source in the
+         * residual network) with a breadth first search, then saturates all the shortest paths with a
+         * blocking flow. The blocking flow is found by an iterative depth first search which only follows
+         * the arcs from a level to the next one, and keeps for each vertex its current arc: the arcs
+         * which lead to a dead end are skipped for the rest of the phase.
+         */
+        template <typename weight_t>
+        class Dinic {
+            static constexpr vertex_t NO_LEVEL = std::numeric_limits<vertex_t>::max();
+
+           public:
+            Dinic(ResidualNetwork<weight_t>& network, vertex_t source, vertex_t sink)
+                : _network(network)
+                , _source(source)
+                , _sink(sink)
+                , _levels(network.size())
+                , _current(network.size()) {}
+
+            /** @brief compute the maximum flow, which is kept in the residual network */
+            weight_t run() {
+                weight_t max_flow = 0;
+                while (compute_levels()) {
+                    std::copy(_network.offsets.begin(), _network.offsets.end() - 1, _current.begin());
+                    max_flow += blocking_flow();
+                }
+                return max_flow;
+            }
+
+           private:
+            /** @brief return true if the sink is reachable in the residual network */
+            bool compute_levels() {
+                std::ranges::fill(_levels, NO_LEVEL);
+                _queue.clear();
+                _levels[_source] = 0;
+                _queue.push_back(_source);
+                for (std::size_t i = 0; i < _queue.size() && _levels[_sink] == NO_LEVEL; ++i) {
+                    auto v = _queue[i];
+                    for (auto arc = _network.offsets[v]; arc < _network.offsets[v + 1]; ++arc) {
+                        auto w = _network.heads[arc];
+                        if (_network.capacities[arc] > 0 && _levels[w] == NO_LEVEL) {
+                            _levels[w] = _levels[v] + 1;
+                            _queue.push_back(w);
+                        }
+                    }
+                }
+                return _levels[_sink] != NO_LEVEL;
+            }
+
+            weight_t blocking_flow() {
+                weight_t flow = 0;
+                // the arcs of the path from the source to v
+                _path.clear();
+                auto v = _source;
+                while (true) {
+                    if (v == _sink) {
+                        weight_t bottleneck = edge_t<weight_t>::D_INFINITY;
+                        for (auto arc : _path) {
+                            bottleneck = std::min(bottleneck, _network.capacities[arc]);
+                        }
+                        for (auto arc : _path) {
+                            _network.push(arc, bottleneck);
+                        }
+                        flow += bottleneck;
+                        // back to the tail of the first saturated arc
+                        auto saturated = std::ranges::find_if(_path, [&](auto arc) {
+                            return _network.capacities[arc] == 0;
+                        });
+                        v = _network.tail(*saturated);
+                        _path.erase(saturated, _path.end());
+                        continue;
+                    }
+                    auto& arc = _current[v];
+                    const auto last = _network.offsets[v + 1];
+                    while (arc < last &&
+                           (_network.capacities[arc] == 0 || _levels[_network.heads[arc]] != _levels[v] + 1)) {
+                        ++arc;
+                    }
+                    if (arc < last) {
+                        _path.push_back(arc);
+                        v = _network.heads[arc];
+                    } else if (v == _source) {
+                        return flow;
+                    } else {
+                        // a dead end: the vertex is not visited again during this phase
+                        _levels[v] = NO_LEVEL;
+                        v = _network.tail(_path.back());
+                        _path.pop_back();
+                        ++_current[v];
+                    }
+                }
+            }
+
+            ResidualNetwork<weight_t>& _network;
+            vertex_t _source;
+            vertex_t _sink;
+            std::vector<vertex_t> _levels;
+            std::vector<std::size_t> _current;
+            std::vector<vertex_t> _queue;
+            std::vector<std::size_t> _path;
+        };
+
+        /**
+         * @brief The highest label push-relabel algorithm
+         * @details the vertices with an excess of flow are discharged by decreasing height. Two heuristics
+         * avoid most of the relabels:
+         * - the global relabeling: the heights are regularly set to the exact distances to the sink (or to
+         * the source plus n, for the vertices which can't reach the sink) with a backward breadth first search
+         * - the gap relabeling: when no vertex is left at a height h < n, the vertices above h can't reach
+         * the sink anymore and are directly lifted to n
+         *
+         * The excesses of the vertices which can't reach the sink are pushed back to the source, so the
+         * result is a flow and not only a preflow.
+         */
+        template <typename weight_t>
+        class PushRelabel {
+            static constexpr vertex_t NONE = std::numeric_limits<vertex_t>::max();
+
+           public:
+            PushRelabel(ResidualNetwork<weight_t>& network, vertex_t source, vertex_t sink)
+                : _network(network)
+                , _n(network.size())
+                , _source(source)
+                , _sink(sink)
+                , _excesses(_n, 0)
+                , _heights(_n, 0)
+                , _current(network.offsets.begin(), network.offsets.end() - 1)
+                , _active(2 * _n)
+                , _layers(_n, NONE)
+                , _next(_n, NONE)
+                , _previous(_n, NONE) {}
+
+            /** @brief compute the maximum flow, which is kept in the residual network */
+            weight_t run() {
+                for (auto arc = _network.offsets[_source]; arc < _network.offsets[_source + 1]; ++arc) {
+                    auto capacity = _network.capacities[arc];
+                    if (capacity > 0) {
+                        _network.push(arc, capacity);
+                        _excesses[_network.heads[arc]] += capacity;
+                    }
+                }
+                global_relabel();
+                while (true) {
+                    while (_highest > 0 && _active[_highest].empty()) {
+                        --_highest;
+                    }
+                    if (_active[_highest].empty()) {
+                        break;
+                    }
+                    auto v = _active[_highest].back();
+                    _active[_highest].pop_back();
+                    // NB: the vertices lifted by a gap are queued again at their new height
+                    if (_heights[v] != _highest || _excesses[v] == 0) {
+                        continue;
+                    }
+                    discharge(v);
+                    if (_n_relabels >= _n) {
+                        global_relabel();
+                    }
+                }
+                return _excesses[_sink];
+            }
+
+            /**
+             * @brief the source side of a minimum cut, after run(): the vertices above the lowest empty height
+             * @details a residual arc never goes down by more than one height, so no residual arc crosses an
+             * empty height downwards: all the edges from the vertices above to the vertices below are saturated
+             */
+            std::vector<bool> get_source_side() const {
+                std::vector<bool> is_used(_n, false);
+                for (auto height : _heights) {
+                    if (height < _n) {
+                        is_used[height] = true;
+                    }
+                }
+                // NB: the sink is at the height 0 and the other n - 2 vertices can't fill the n - 1 other heights
+                auto gap = std::distance(is_used.begin(), std::ranges::find(is_used, false));
+                std::vector<bool> is_source_side(_n);
+                for (vertex_t v = 0; v < _n; ++v) {
+                    is_source_side[v] = _heights[v] > static_cast<vertex_t>(gap);
+                }
+                return is_source_side;
+            }
+
+           private:
+            bool is_active(vertex_t v) const {
+                return v != _source && v != _sink && _excesses[v] > 0 && _heights[v] < 2 * _n;
+            }
+
+            void activate(vertex_t v) {
+                _active[_heights[v]].push_back(v);
+                _highest = std::max<std::size_t>(_highest, _heights[v]);
+            }
+
+            /** @brief add a vertex to the list of the vertices of its height (for the heights lower than n) */
+            void add_to_layer(vertex_t v) {
+                auto h = _heights[v];
+                _previous[v] = NONE;
+                _next[v] = _layers[h];
+                if (_layers[h] != NONE) {
+                    _previous[_layers[h]] = v;
+                }
+                _layers[h] = v;
+                _highest_layer = std::max<std::size_t>(_highest_layer, h);
+            }
+
+            void remove_from_layer(vertex_t v) {
+                if (_previous[v] != NONE) {
+                    _next[_previous[v]] = _next[v];
+                } else {
+                    _layers[_heights[v]] = _next[v];
+                }
+                if (_next[v] != NONE) {
+                    _previous[_next[v]] = _previous[v];
+                }
+            }
+
+            /** @brief push the excess of v to its neighbors, relabeling v when needed */
+            void discharge(vertex_t v) {
+                while (_excesses[v] > 0) {
+                    auto& arc = _current[v];
+                    if (arc == _network.offsets[v + 1]) {
+                        relabel(v);
+                        if (_heights[v] >= 2 * _n) {
+                            return;
+                        }
+                        continue;
+                    }
+                    auto w = _network.heads[arc];
+                    if (_network.capacities[arc] > 0 && _heights[v] == _heights[w] + 1) {
+                        auto flow = std::min(_excesses[v], _network.capacities[arc]);
+                        _network.push(arc, flow);
+                        _excesses[v] -= flow;
+                        bool was_active = is_active(w);
+                        _excesses[w] += flow;
+                        if (!was_active && is_active(w)) {
+                            activate(w);
+                        }
+                    } else {
+                        ++arc;
+                    }
+                }
+            }
+
+            /** @brief lift v just above its lowest residual neighbor, or all the vertices above a gap */
+            void relabel(vertex_t v) {
+                ++_n_relabels;
+                const auto height = _heights[v];
+                vertex_t new_height = 2 * _n;
+                for (auto arc = _network.offsets[v]; arc < _network.offsets[v + 1]; ++arc) {
+                    if (_network.capacities[arc] > 0) {
+                        new_height = std::min(new_height, _heights[_network.heads[arc]] + 1);
+                    }
+                }
+                _current[v] = _network.offsets[v];
+                if (height < _n) {
+                    remove_from_layer(v);
+                    if (_layers[height] == NONE) {
+                        // a gap: the vertices above can't reach the sink anymore
+                        for (auto h = height + 1; h <= _highest_layer; ++h) {
+                            for (auto u = _layers[h]; u != NONE; u = _next[u]) {
+                                _heights[u] = _n;
+                                _current[u] = _network.offsets[u];
+                                if (is_active(u)) {
+                                    activate(u);
+                                }
+                            }
+                            _layers[h] = NONE;
+                        }
+                        _highest_layer = height;
+                        new_height = std::max(new_height, _n);
+                    }
+                }
+                _heights[v] = new_height;
+                if (new_height < _n) {
+                    add_to_layer(v);
+                }
+            }
+
+            /**
+             * @brief set the heights to the distances to the sink in the residual network, or to the
+             * distances to the source plus n for the vertices which can't reach the sink
+             */
+            void global_relabel() {
+                _n_relabels = 0;
+                std::ranges::fill(_heights, 2 * _n);
+                std::ranges::fill(_layers, NONE);
+                _highest_layer = 0;
+                for (auto& active : _active) {
+                    active.clear();
+                }
+                _highest = 0;
+
+                // backward breadth first searches: the arc u -> w is the reverse of an arc of w
+                auto search_from = [&](vertex_t root, vertex_t height) {
+                    auto first = _queue.size();
+                    _heights[root] = height;
+                    _queue.push_back(root);
+                    for (auto i = first; i < _queue.size(); ++i) {
+                        auto w = _queue[i];
+                        for (auto arc = _network.offsets[w]; arc < _network.offsets[w + 1]; ++arc) {
+                            auto u = _network.heads[arc];
+                            if (u != _source && _heights[u] == 2 * _n && _network.capacities[_network.reverse[arc]] > 0) {
+                                _heights[u] = _heights[w] + 1;
+                                _queue.push_back(u);
+                            }
+                        }
+                    }
+                };
+                _queue.clear();
+                search_from(_sink, 0);
+                search_from(_source, _n);
+
+                for (vertex_t v = 0; v < _n; ++v) {
+                    _current[v] = _network.offsets[v];
+                    if (_heights[v] < _n) {
+                        add_to_layer(v);
+                    }
+                    if (is_active(v)) {
+                        activate(v);
+                    }
+                }
+            }
+
+            ResidualNetwork<weight_t>& _network;
+            vertex_t _n;
+            vertex_t _source;
+            vertex_t _sink;
+            std::vector<weight_t> _excesses;
+            std::vector<vertex_t> _heights;
+            std::vector<std::size_t> _current;
+            // the active vertices by height (some may be outdated)
+            std::vector<std::vector<vertex_t>> _active;
+            std::size_t _highest = 0;
+            // the doubly linked lists of the vertices by height, for the heights lower than n
+            std::vector<vertex_t> _layers;
+            std::vector<vertex_t> _next;
+            std::vector<vertex_t> _previous;
+            std::size_t _highest_layer = 0;
+            std::size_t _n_relabels = 0;
+            std::vector<vertex_t> _queue;
+        };
+
+        template <typename G>
+        void check_flow_network(const G& graph, vertex_t start, vertex_t end) {
+            assert(start < graph.size() && end < graph.size());
+            if (!graph.is_directed()) {
+                throw error("maximum_flow: the graph must be directed");
+            }
+            if (start == end) {
+                throw error("maximum_flow: the source and the sink must be different");
+            }
+        }
+    } // namespace internal
+
     /**
      * @brief Compute the maximum flow of a graph. Edges weights are used as capacities.
      * @tparam G The graph implementation
@@ -9,43 +455,57 @@ namespace grafology {
      * @param start The source vertex
      * @param end The sink vertex
      * @return The maximum flow
-     * @remark This is based on the Ford-Fulkerson algorithm
-     * @todo Investigate the Push Relabel algorithm which should be faster
+     * @remark This is based on the highest label push-relabel algorithm (see maximum_flow_push_relabel())
      */
     template <typename G>
     requires GraphImpl<G, typename G::weight_lt>
     typename G::weight_lt maximum_flow(const G& graph, vertex_t start, vertex_t end) {
-        using weight_lt = typename G::weight_lt;
+        internal::check_flow_network(graph, start, end);
+        internal::ResidualNetwork<typename G::weight_lt> network(graph);
+        return internal::PushRelabel(network, start, end).run();
+    }
 
-        assert(start < graph.size() && end < graph.size());
-        if(!graph.is_directed()) {
-            throw error("maximum_flow: the graph must be directed");
-        }
+    /**
+     * @brief Compute the maximum flow of a graph and the flow of each edge. Edges weights are used as capacities.
+     * @remark This is based on the Dinic's algorithm, on a residual network with paired arcs (see internal::Dinic)
+     * @throw error if the graph is undirected or if start and end are the same vertex
+     */
+    template <typename G>
+    requires GraphImpl<G, typename G::weight_lt>
+    MaximumFlowImpl<G> maximum_flow_dinic(const G& graph, vertex_t start, vertex_t end) {
+        internal::check_flow_network(graph, start, end);
+        internal::ResidualNetwork<typename G::weight_lt> network(graph);
+        auto value = internal::Dinic(network, start, end).run();
+        return {value, network.get_flows(graph)};
+    }
 
-        // the residual graph
-        G residual_graph= graph;
-        weight_lt max_flow = 0;
-        DFSPathFinder dfs(residual_graph);
-        
-        while (true) {
-            if (!dfs.find(start, end)) {
-                break;
-            }
-            weight_lt path_flow = edge_t<weight_lt>::D_INFINITY;
-            for (vertex_t v = end; v != start; v = dfs.get_parent(v)) {
-                auto u = dfs.get_parent(v);
-                auto w = residual_graph.weight(u, v);
-                path_flow = std::min(path_flow, w);
-            }
-            for (vertex_t v = end; v != start; v = dfs.get_parent(v)) {
-                vertex_t u = dfs.get_parent(v);
-                residual_graph.set_edge(u, v, residual_graph.weight(u, v) - path_flow);
-            }
-            max_flow += path_flow;
-        }
-        return max_flow;
+    /**
+     * @brief Compute the maximum flow of a graph and the flow of each edge. Edges weights are used as capacities.
+     * @remark This is based on the highest label push-relabel algorithm with the global and gap relabeling
+     * heuristics, on a residual network with paired arcs (see internal::PushRelabel)
+     * @throw error if the graph is undirected or if start and end are the same vertex
+     */
+    template <typename G>
+    requires GraphImpl<G, typename G::weight_lt>
+    MaximumFlowImpl<G> maximum_flow_push_relabel(const G& graph, vertex_t start, vertex_t end) {
+        internal::check_flow_network(graph, start, end);
+        internal::ResidualNetwork<typename G::weight_lt> network(graph);
+        auto value = internal::PushRelabel(network, start, end).run();
+        return {value, network.get_flows(graph)};
     }
 
+    /**
+     * @brief The maximum flow of a graph
+     * @details the flows are stored as a graph with the same vertices, whose weights are the flows
+     * of the edges (the edges without flow are absent)
+     */
+    template <typename Impl, VertexKey Vertex>
+    requires GraphImpl<Impl, typename Impl::weight_lt>
+    struct MaximumFlow {
+        typename Impl::weight_lt value;
+        Graph<Impl, Vertex, true, typename Impl::weight_lt> flows;
+    };
+
     /**
      * @brief Compute the maximum flow of a graph. Edges weights are used as capacities.
      * @tparam G The graph implementation
@@ -53,8 +513,7 @@ namespace grafology {
      * @param start The source vertex
      * @param end The sink vertex
      * @return The maximum flow
-     * @remark This is based on the Ford-Fulkerson algorithm
-     * @todo Investigate the Push Relabel algorithm which should be faster
+     * @remark This is based on the highest label push-relabel algorithm
      */
     template<typename Impl, VertexKey Vertex>
     requires GraphImpl<Impl, typename Impl::weight_lt>
@@ -70,4 +529,38 @@ namespace grafology {
         return 0;
     }
 
+    /**
+     * @brief Compute the maximum flow of a graph and the flow of each edge, with the Dinic's algorithm
+     */
+    template<typename Impl, VertexKey Vertex>
+    requires GraphImpl<Impl, typename Impl::weight_lt>
+    MaximumFlow<Impl, Vertex> maximum_flow_dinic(const Graph<Impl, Vertex, true, typename Impl::weight_lt>& graph, const Vertex& start, const Vertex& end) {
+        assert(graph.get_internal_index(start) != INVALID_VERTEX && graph.get_internal_index(end) != INVALID_VERTEX);
+        auto res = maximum_flow_dinic(graph.impl(), graph.get_internal_index(start), graph.get_internal_index(end));
+        return {res.value, {graph, std::move(res.flows)}};
+    }
+
+    template<typename Impl, VertexKey Vertex>
+    requires GraphImpl<Impl, typename Impl::weight_lt>
+    MaximumFlow<Impl, Vertex> maximum_flow_dinic(const Graph<Impl, Vertex, false, typename Impl::weight_lt>& graph, const Vertex& start, const Vertex& end) {
+        static_assert(false, "Maximum flow works only on directed graphs");
+    }
+
+    /**
+     * @brief Compute the maximum flow of a graph and the flow of each edge, with the push-relabel algorithm
+     */
+    template<typename Impl, VertexKey Vertex>
+    requires GraphImpl<Impl, typename Impl::weight_lt>
+    MaximumFlow<Impl, Vertex> maximum_flow_push_relabel(const Graph<Impl, Vertex, true, typename Impl::weight_lt>& graph, const Vertex& start, const Vertex& end) {
+        assert(graph.get_internal_index(start) != INVALID_VERTEX && graph.get_internal_index(end) != INVALID_VERTEX);
+        auto res = maximum_flow_push_relabel(graph.impl(), graph.get_internal_index(start), graph.get_internal_index(end));
+        return {res.value, {graph, std::move(res.flows)}};
+    }
+
+    template<typename Impl, VertexKey Vertex>
+    requires GraphImpl<Impl, typename Impl::weight_lt>
+    MaximumFlow<Impl, Vertex> maximum_flow_push_relabel(const Graph<Impl, Vertex, false, typename Impl::weight_lt>& graph, const Vertex& start, const Vertex& end) {
+        static_assert(false, "Maximum flow works only on directed graphs");
+    }
+
 } // namespace grafology
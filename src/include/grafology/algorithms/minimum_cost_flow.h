@@ -0,0 +1,310 @@
+#pragma once
+#include "../graph.h"
+#include "../indexed_heap.h"
+#include "maximum_flow.h"
+#include <algorithm>
+#include <deque>
+#include <vector>
+
+namespace grafology {
+    //==============================================================================
+    // Implementation Graphs
+    //==============================================================================
+
+    /**
+     * @brief The result of the minimum cost flow algorithm
+     * @details the flows are stored as a graph of the same type as the flow network, whose weights
+     * are the flows of the edges (the edges without flow are absent)
+     */
+    template <typename G, typename cost_t>
+    struct MinimumCostFlowImpl {
+        typename G::weight_lt value;
+        cost_t cost;
+        G flows;
+    };
+
+    namespace internal {
+        /**
+         * @brief The successive shortest paths algorithm
+         * @details the flow is augmented along a cheapest path from the source to the sink in the residual
+         * network, until the sink can't be reached or the requested flow is reached. The cheapest paths are
+         * found by Dijkstra's algorithm on the reduced costs cost(u, v) + p(u) - p(v), where the potentials p
+         * (Johnson's reweighting) are updated with the distances of each search, so the reduced costs of the
+         * residual arcs are never negative. The initial potentials are computed by the Bellman-Ford algorithm
+         * (queue based) only if some costs are negative.
+         */
+        template <typename weight_t, typename cost_t>
+        class SuccessiveShortestPaths {
+            static constexpr auto D_INFINITY = edge_t<cost_t>::D_INFINITY;
+            static constexpr std::size_t NO_ARC = std::numeric_limits<std::size_t>::max();
+
+           public:
+            /** @param costs the cost of each forward arc of the network (its reverse arc costs the opposite) */
+            SuccessiveShortestPaths(
+                ResidualNetwork<weight_t>& network,
+                const std::vector<cost_t>& costs,
+                vertex_t source,
+                vertex_t sink
+            )
+                : _network(network)
+                , _n(network.size())
+                , _source(source)
+                , _sink(sink)
+                , _costs(network.heads.size(), 0)
+                , _potentials(_n, 0)
+                , _distances(_n, D_INFINITY)
+                , _predecessors(_n, NO_ARC)
+                , _heap(_n) {
+                for (std::size_t e = 0; e < network.forward_arcs.size(); ++e) {
+                    auto arc = network.forward_arcs[e];
+                    _costs[arc] = costs[e];
+                    _costs[network.reverse[arc]] = -costs[e];
+                }
+                // NB: the reverse arcs have the opposite costs, only the costs of the edges matter
+                _has_negative_costs = std::ranges::any_of(costs, [](auto cost) { return cost < 0; });
+            }
+
+            /** @brief true if some edges have a negative cost, so the initial potentials need the Bellman-Ford algorithm */
+            bool has_negative_costs() const { return _has_negative_costs; }
+
+            /**
+             * @brief send at most max_flow units of flow from the source to the sink, at a minimum cost
+             * @return the flow and its cost. The flow of each edge is kept in the residual network.
+             * @throw error if a cycle of negative cost can be reached from the source
+             */
+            std::pair<weight_t, cost_t> run(weight_t max_flow) {
+                if (_has_negative_costs) {
+                    compute_initial_potentials();
+                }
+                weight_t flow = 0;
+                cost_t cost = 0;
+                while (flow < max_flow && find_cheapest_path()) {
+                    weight_t bottleneck = max_flow - flow;
+                    for (auto v = _sink; v != _source; v = _network.tail(_predecessors[v])) {
+                        bottleneck = std::min(bottleneck, _network.capacities[_predecessors[v]]);
+                    }
+                    for (auto v = _sink; v != _source; v = _network.tail(_predecessors[v])) {
+                        _network.push(_predecessors[v], bottleneck);
+                        cost += bottleneck * _costs[_predecessors[v]];
+                    }
+                    flow += bottleneck;
+                }
+                return {flow, cost};
+            }
+
+           private:
+            cost_t reduced_cost(std::size_t arc, vertex_t u) const {
+                auto reduced = _costs[arc] + _potentials[u] - _potentials[_network.heads[arc]];
+                if constexpr (std::floating_point<cost_t>) {
+                    // the rounding errors must not give negative costs
+                    reduced = std::max<cost_t>(reduced, 0);
+                }
+                assert(reduced >= 0);
+                return reduced;
+            }
+
+            /**
+             * @brief Dijkstra's algorithm from the source, which stops when the sink is settled
+             * @return true if the sink is reachable in the residual network
+             */
+            bool find_cheapest_path() {
+                for (auto v : _reached) {
+                    _distances[v] = D_INFINITY;
+                    _predecessors[v] = NO_ARC;
+                }
+                _reached.clear();
+                _heap.clear();
+
+                _distances[_source] = 0;
+                _reached.push_back(_source);
+                _heap.push(_source, 0);
+                while (!_heap.empty()) {
+                    auto [d, u] = _heap.pop();
+                    if (u == _sink) {
+                        break;
+                    }
+                    for (auto arc = _network.offsets[u]; arc < _network.offsets[u + 1]; ++arc) {
+                        if (_network.capacities[arc] == 0) {
+                            continue;
+                        }
+                        auto v = _network.heads[arc];
+                        auto new_d = d + reduced_cost(arc, u);
+                        if (new_d < _distances[v]) {
+                            if (_distances[v] == D_INFINITY) {
+                                _reached.push_back(v);
+                            }
+                            _distances[v] = new_d;
+                            _predecessors[v] = arc;
+                            _heap.push_or_decrease(v, new_d);
+                        }
+                    }
+                }
+                if (_distances[_sink] == D_INFINITY) {
+                    return false;
+                }
+
+                // p(v) += min(d(v), d(sink)) keeps the reduced costs positive for all the vertices
+                // (including the ones which have not been settled), and gives 0 along the path
+                const auto d_sink = _distances[_sink];
+                for (vertex_t v = 0; v < _n; ++v) {
+                    _potentials[v] += std::min(_distances[v], d_sink);
+                }
+                return true;
+            }
+
+            /** @brief the distances from the source, with the Bellman-Ford algorithm */
+            void compute_initial_potentials() {
+                std::ranges::fill(_potentials, D_INFINITY);
+                std::vector<bool> is_queued(_n, false);
+                std::vector<vertex_t> n_updates(_n, 0);
+                std::deque<vertex_t> queue = {_source};
+                _potentials[_source] = 0;
+                is_queued[_source] = true;
+                while (!queue.empty()) {
+                    auto u = queue.front();
+                    queue.pop_front();
+                    is_queued[u] = false;
+                    for (auto arc = _network.offsets[u]; arc < _network.offsets[u + 1]; ++arc) {
+                        auto v = _network.heads[arc];
+                        if (_network.capacities[arc] > 0 && _potentials[u] + _costs[arc] < _potentials[v]) {
+                            _potentials[v] = _potentials[u] + _costs[arc];
+                            if (!is_queued[v]) {
+                                if (++n_updates[v] >= _n) {
+                                    throw error("minimum_cost_flow: a cycle of negative cost can be reached from the source");
+                                }
+                                is_queued[v] = true;
+                                queue.push_back(v);
+                            }
+                        }
+                    }
+                }
+                // the vertices which can't be reached from the source are never used by a path
+                for (auto& potential : _potentials) {
+                    if (potential == D_INFINITY) {
+                        potential = 0;
+                    }
+                }
+            }
+
+            ResidualNetwork<weight_t>& _network;
+            vertex_t _n;
+            vertex_t _source;
+            vertex_t _sink;
+            std::vector<cost_t> _costs;
+            bool _has_negative_costs = false;
+            std::vector<cost_t> _potentials;
+            std::vector<cost_t> _distances;
+            // the arc to each vertex in the cheapest paths tree
+            std::vector<std::size_t> _predecessors;
+            typename DijkstraHeap<cost_t>::type _heap;
+            // the vertices whose distance has been set by the last search
+            std::vector<vertex_t> _reached;
+        };
+
+        /** @brief the costs of the forward arcs of the network, given by cost(u, v) for each edge (u, v) */
+        template <typename weight_t, typename F>
+        auto get_arc_costs(const ResidualNetwork<weight_t>& network, F&& cost) {
+            std::vector<std::remove_cvref_t<decltype(cost(vertex_t{}, vertex_t{}))>> costs;
+            costs.reserve(network.forward_arcs.size());
+            for (auto arc : network.forward_arcs) {
+                costs.push_back(cost(network.tail(arc), network.heads[arc]));
+            }
+            return costs;
+        }
+    } // namespace internal
+
+    /**
+     * @brief Compute a flow of minimum cost from a source to a sink
+     * @details the weights of graph are used as capacities, and the weights of costs are the costs of a
+     * unit of flow on the same edges (the edges absent from costs are free). The flow is the maximum flow,
+     * or max_flow if it's lower.
+     * @remark This is based on the successive shortest paths algorithm with Johnson's potentials, whose
+     * paths are found by Dijkstra's algorithm (see internal::SuccessiveShortestPaths). Its complexity is
+     * O(F (E + V log V)) for a flow F, as each path carries at least one unit of flow.
+     * @remark The costs may be negative, but no cycle of negative cost may be reached from the source.
+     * @throw error if the graph is undirected, if start and end are the same vertex or if a cycle of
+     * negative cost can be reached from start
+     */
+    template <typename G, typename C>
+    requires GraphImpl<G, typename G::weight_lt> && GraphImpl<C, typename C::weight_lt>
+    MinimumCostFlowImpl<G, typename C::weight_lt> minimum_cost_flow(
+        const G& graph,
+        const C& costs,
+        vertex_t start,
+        vertex_t end,
+        typename G::weight_lt max_flow = edge_t<typename G::weight_lt>::D_INFINITY
+    ) {
+        internal::check_flow_network(graph, start, end);
+        assert(costs.size() == graph.size());
+        internal::ResidualNetwork<typename G::weight_lt> network(graph);
+        auto arc_costs = internal::get_arc_costs(network, [&](vertex_t u, vertex_t v) { return costs.weight(u, v); });
+        auto [value, cost] = internal::SuccessiveShortestPaths(network, arc_costs, start, end).run(max_flow);
+        return {value, cost, network.get_flows(graph)};
+    }
+
+    //==============================================================================
+    // Graphs
+    //==============================================================================
+
+    /**
+     * @brief The minimum cost flow of a graph
+     * @details the flows are stored as a graph with the same vertices, whose weights are the flows
+     * of the edges (the edges without flow are absent)
+     */
+    template <typename Impl, VertexKey Vertex, typename cost_t>
+    requires GraphImpl<Impl, typename Impl::weight_lt>
+    struct MinimumCostFlow {
+        typename Impl::weight_lt value;
+        cost_t cost;
+        Graph<Impl, Vertex, true, typename Impl::weight_lt> flows;
+    };
+
+    /**
+     * @brief Compute a flow of minimum cost from a source to a sink
+     * @details costs must have the same vertices as graph (its edges may differ, the absent edges are free)
+     * @see minimum_cost_flow(const G&, const C&, vertex_t, vertex_t, typename G::weight_lt)
+     */
+    template <typename Impl, typename CostImpl, VertexKey Vertex>
+    requires GraphImpl<Impl, typename Impl::weight_lt> && GraphImpl<CostImpl, typename CostImpl::weight_lt>
+    MinimumCostFlow<Impl, Vertex, typename CostImpl::weight_lt> minimum_cost_flow(
+        const Graph<Impl, Vertex, true, typename Impl::weight_lt>& graph,
+        const Graph<CostImpl, Vertex, true, typename CostImpl::weight_lt>& costs,
+        const Vertex& start,
+        const Vertex& end,
+        std::type_identity_t<typename Impl::weight_lt> max_flow = edge_t<typename Impl::weight_lt>::D_INFINITY
+    ) {
+        assert(graph.get_internal_index(start) != INVALID_VERTEX && graph.get_internal_index(end) != INVALID_VERTEX);
+        const auto s = graph.get_internal_index(start);
+        const auto t = graph.get_internal_index(end);
+        internal::check_flow_network(graph.impl(), s, t);
+
+        // the internal indices of the vertices in costs
+        std::vector<vertex_t> cost_indices(graph.impl().size());
+        for (vertex_t v = 0; v < cost_indices.size(); ++v) {
+            cost_indices[v] = costs.get_internal_index(graph.get_vertex_from_internal_index(v));
+        }
+        auto cost = [&](vertex_t u, vertex_t v) -> typename CostImpl::weight_lt {
+            if (cost_indices[u] == INVALID_VERTEX || cost_indices[v] == INVALID_VERTEX) {
+                return 0;
+            }
+            return costs.impl().weight(cost_indices[u], cost_indices[v]);
+        };
+
+        internal::ResidualNetwork<typename Impl::weight_lt> network(graph.impl());
+        auto arc_costs = internal::get_arc_costs(network, cost);
+        auto [value, total_cost] = internal::SuccessiveShortestPaths(network, arc_costs, s, t).run(max_flow);
+        return {value, total_cost, {graph, network.get_flows(graph.impl())}};
+    }
+
+    template <typename Impl, typename CostImpl, VertexKey Vertex>
+    requires GraphImpl<Impl, typename Impl::weight_lt> && GraphImpl<CostImpl, typename CostImpl::weight_lt>
+    MinimumCostFlow<Impl, Vertex, typename CostImpl::weight_lt> minimum_cost_flow(
+        const Graph<Impl, Vertex, false, typename Impl::weight_lt>& graph,
+        const Graph<CostImpl, Vertex, false, typename CostImpl::weight_lt>& costs,
+        const Vertex& start,
+        const Vertex& end,
+        std::type_identity_t<typename Impl::weight_lt> max_flow = edge_t<typename Impl::weight_lt>::D_INFINITY
+    ) {
+        static_assert(false, "Minimum cost flow works only on directed graphs");
+    }
+} // namespace grafology
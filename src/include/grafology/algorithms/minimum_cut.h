@@ -0,0 +1,446 @@
+#pragma once
+#include "../graph.h"
+#include "../disjoint_set.h"
+#include "maximum_flow.h"
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+#include <numbers>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace grafology {
+    //==============================================================================
+    // Implementation Graphs
+    //==============================================================================
+
+    /**
+     * @brief The result of the minimum cut algorithms
+     */
+    template <typename weight_t>
+    struct MinimumCutImpl {
+        // the sum of the weights of the cut edges
+        weight_t value;
+        // one side of the cut (the source side for a s-t cut)
+        std::vector<vertex_t> vertices;
+        // the edges from the vertices of this side to the other side
+        std::vector<edge_t<weight_t>> edges;
+    };
+
+    namespace internal {
+        /** @brief the cut between the vertices of a side and the others */
+        template <typename G>
+        MinimumCutImpl<typename G::weight_lt> make_cut(const G& graph, const std::vector<bool>& is_in_side) {
+            MinimumCutImpl<typename G::weight_lt> res {0, {}, {}};
+            for (vertex_t v = 0; v < graph.size(); ++v) {
+                if (!is_in_side[v]) {
+                    continue;
+                }
+                res.vertices.push_back(v);
+                for_each_neighbor(graph, v, [&](const auto& edge) {
+                    if (!is_in_side[edge.end]) {
+                        res.value += edge.weight;
+                        res.edges.push_back(edge);
+                    }
+                });
+            }
+            return res;
+        }
+
+        template <typename G>
+        void check_global_cut(const G& graph) {
+            if (graph.is_directed()) {
+                throw error("minimum_cut: the graph must be undirected");
+            }
+            if (graph.size() < 2) {
+                throw error("minimum_cut: the graph must have at least 2 vertices");
+            }
+        }
+
+        /**
+         * @brief The Stoer-Wagner algorithm on a n x n matrix of weights
+         * @details each phase adds the vertices one by one, the next one being the most tightly connected
+         * to the vertices already added (maximum adjacency order). The weight of the last vertex is the
+         * minimum cut between the last two vertices, which are then merged.
+         * @return the weight of the minimum cut and the vertices of one side
+         */
+        template <typename weight_t>
+        std::pair<weight_t, std::vector<bool>> stoer_wagner(std::vector<weight_t> weights, vertex_t n) {
+            std::vector<std::vector<vertex_t>> members(n);
+            for (vertex_t v = 0; v < n; ++v) {
+                members[v] = {v};
+            }
+            std::vector<vertex_t> active(n);
+            std::iota(active.begin(), active.end(), 0);
+            std::vector<weight_t> keys(n);
+            std::vector<bool> is_added(n);
+
+            weight_t best = edge_t<weight_t>::D_INFINITY;
+            std::vector<vertex_t> best_side;
+            while (active.size() > 1) {
+                for (auto v : active) {
+                    keys[v] = 0;
+                    is_added[v] = false;
+                }
+                auto previous = active[0];
+                auto last = active[0];
+                for (std::size_t i = 0; i < active.size(); ++i) {
+                    auto selected = INVALID_VERTEX;
+                    for (auto v : active) {
+                        if (!is_added[v] && (selected == INVALID_VERTEX || keys[v] > keys[selected])) {
+                            selected = v;
+                        }
+                    }
+                    is_added[selected] = true;
+                    previous = last;
+                    last = selected;
+                    for (auto v : active) {
+                        if (!is_added[v]) {
+                            keys[v] += weights[selected * n + v];
+                        }
+                    }
+                }
+                if (keys[last] < best) {
+                    best = keys[last];
+                    best_side = members[last];
+                }
+                // the last vertex is merged in the previous one
+                for (auto v : active) {
+                    weights[previous * n + v] += weights[last * n + v];
+                    weights[v * n + previous] = weights[previous * n + v];
+                }
+                weights[previous * n + previous] = 0;
+                members[previous].insert(members[previous].end(), members[last].begin(), members[last].end());
+                std::erase(active, last);
+            }
+
+            std::vector<bool> is_in_side(n, false);
+            for (auto v : best_side) {
+                is_in_side[v] = true;
+            }
+            return {best, std::move(is_in_side)};
+        }
+
+        /**
+         * @brief The Karger-Stein algorithm
+         * @details the graph is contracted by merging the ends of random edges (chosen with a probability
+         * proportional to their weights) until n / sqrt(2) vertices are left, which keeps a given minimum cut
+         * with a probability of at least 1/2. The contracted graph is cut recursively twice, and the smallest
+         * cut is kept. A run finds a minimum cut with a probability in O(1 / log n).
+         */
+        template <typename weight_t>
+        class KargerStein {
+           public:
+            // the vertices are numbered from 0 to n - 1 and the parallel edges are merged
+            struct Multigraph {
+                vertex_t n;
+                std::vector<edge_t<weight_t>> edges;
+            };
+            using Cut = std::pair<weight_t, std::vector<bool>>;
+
+            // the graphs with at most BASE_SIZE vertices are cut with the Stoer-Wagner algorithm, which is
+            // deterministic and faster than the last levels of the recursion
+            static constexpr vertex_t BASE_SIZE = 32;
+
+            static Cut run(const Multigraph& graph, std::mt19937_64& rng) {
+                if (graph.edges.empty()) {
+                    std::vector<bool> is_in_side(graph.n, false);
+                    is_in_side[0] = true;
+                    return {0, std::move(is_in_side)};
+                }
+                if (graph.n <= BASE_SIZE) {
+                    std::vector<weight_t> weights(graph.n * graph.n, 0);
+                    for (const auto& edge : graph.edges) {
+                        weights[edge.start * graph.n + edge.end] += edge.weight;
+                        weights[edge.end * graph.n + edge.start] += edge.weight;
+                    }
+                    return stoer_wagner(std::move(weights), graph.n);
+                }
+
+                const auto target = static_cast<vertex_t>(std::ceil(1 + graph.n / std::numbers::sqrt2));
+                Cut best {edge_t<weight_t>::D_INFINITY, {}};
+                std::vector<vertex_t> labels;
+                for (int i = 0; i < 2; ++i) {
+                    auto contracted = contract(graph, target, rng, labels);
+                    auto [value, is_in_side] = run(contracted, rng);
+                    if (value < best.first) {
+                        best.first = value;
+                        best.second.resize(graph.n);
+                        for (vertex_t v = 0; v < graph.n; ++v) {
+                            best.second[v] = is_in_side[labels[v]];
+                        }
+                    }
+                }
+                return best;
+            }
+
+           private:
+            /** @brief contract random edges until target vertices are left. labels gives the new vertex of each vertex */
+            static Multigraph contract(
+                const Multigraph& graph,
+                vertex_t target,
+                std::mt19937_64& rng,
+                std::vector<vertex_t>& labels
+            ) {
+                // sorting the edges by exponential keys of rate weight gives a random order where each next edge
+                // is chosen with a probability proportional to its weight
+                std::exponential_distribution<double> exponential;
+                std::vector<std::pair<double, std::size_t>> order(graph.edges.size());
+                for (std::size_t e = 0; e < graph.edges.size(); ++e) {
+                    order[e] = {exponential(rng) / static_cast<double>(graph.edges[e].weight), e};
+                }
+                std::ranges::sort(order);
+
+                DisjointSet components(graph.n);
+                for (const auto& [_, e] : order) {
+                    if (components.count() <= target) {
+                        break;
+                    }
+                    components.merge(graph.edges[e].start, graph.edges[e].end);
+                }
+
+                std::vector<vertex_t> root_labels(graph.n, INVALID_VERTEX);
+                labels.resize(graph.n);
+                Multigraph res {0, {}};
+                for (vertex_t v = 0; v < graph.n; ++v) {
+                    auto root = components.find(v);
+                    if (root_labels[root] == INVALID_VERTEX) {
+                        root_labels[root] = res.n++;
+                    }
+                    labels[v] = root_labels[root];
+                }
+                for (const auto& edge : graph.edges) {
+                    auto u = labels[edge.start];
+                    auto v = labels[edge.end];
+                    if (u != v) {
+                        res.edges.push_back({std::min(u, v), std::max(u, v), edge.weight});
+                    }
+                }
+                // the parallel edges are merged
+                std::ranges::sort(res.edges, {}, [](const auto& edge) { return std::pair(edge.start, edge.end); });
+                std::size_t n_edges = 0;
+                for (const auto& edge : res.edges) {
+                    if (n_edges > 0 && res.edges[n_edges - 1].start == edge.start
+                        && res.edges[n_edges - 1].end == edge.end) {
+                        res.edges[n_edges - 1].weight += edge.weight;
+                    } else {
+                        res.edges[n_edges++] = edge;
+                    }
+                }
+                res.edges.resize(n_edges);
+                return res;
+            }
+        };
+    } // namespace internal
+
+    /**
+     * @brief Compute a minimum cut between two vertices
+     * @details the source side is given by the heights of the push-relabel algorithm (see
+     * internal::PushRelabel::get_source_side()), without any other traversal of the graph
+     * @remark for an undirected graph, each edge can be used in both directions
+     * @throw error if the source and the sink are the same vertex
+     */
+    template <typename G>
+    requires GraphImpl<G, typename G::weight_lt>
+    MinimumCutImpl<typename G::weight_lt> minimum_cut(const G& graph, vertex_t source, vertex_t sink) {
+        assert(source < graph.size() && sink < graph.size());
+        if (source == sink) {
+            throw error("minimum_cut: the source and the sink must be different");
+        }
+        internal::ResidualNetwork<typename G::weight_lt> network(graph);
+        internal::PushRelabel push_relabel(network, source, sink);
+        push_relabel.run();
+        return internal::make_cut(graph, push_relabel.get_source_side());
+    }
+
+    /**
+     * @brief Compute a global minimum cut of an undirected graph
+     * @remark this is based on the Stoer-Wagner algorithm, on a matrix of weights: O(n^3) in time and
+     * O(n^2) in memory, which suits the dense graphs
+     * @throw error if the graph is directed or has less than 2 vertices
+     */
+    template <typename G>
+    requires GraphImpl<G, typename G::weight_lt>
+    MinimumCutImpl<typename G::weight_lt> minimum_cut_stoer_wagner(const G& graph) {
+        internal::check_global_cut(graph);
+        const vertex_t n = graph.size();
+        std::vector<typename G::weight_lt> weights(static_cast<std::size_t>(n) * n, 0);
+        for (vertex_t u = 0; u < n; ++u) {
+            for_each_neighbor(graph, u, [&](const auto& edge) {
+                weights[static_cast<std::size_t>(u) * n + edge.end] = edge.weight;
+            });
+        }
+        auto [_, is_in_side] = internal::stoer_wagner(std::move(weights), n);
+        return internal::make_cut(graph, is_in_side);
+    }
+
+    /**
+     * @brief Compute a global minimum cut of an undirected graph, with a high probability
+     * @remark this is based on the Karger-Stein algorithm, whose runs are shared between several threads.
+     * The smallest cut of the runs is kept: with ln(n)^2 runs, it is a minimum cut with a probability
+     * of at least 1 - 1/n. A run only works on lists of edges, which suits the sparse graphs.
+     * @param n_trials the number of runs (0 for ln(n)^2)
+     * @param n_threads the number of threads (0 for the hardware concurrency)
+     * @param seed the seed of the random generators: the result only depends on it, not on n_threads
+     * @throw error if the graph is directed or has less than 2 vertices
+     */
+    template <typename G>
+    requires GraphImpl<G, typename G::weight_lt>
+    MinimumCutImpl<typename G::weight_lt> minimum_cut_karger_stein(
+        const G& graph,
+        unsigned n_trials = 0,
+        unsigned n_threads = 0,
+        std::uint64_t seed = 0
+    ) {
+        using weight_lt = typename G::weight_lt;
+        using KargerStein = internal::KargerStein<weight_lt>;
+        internal::check_global_cut(graph);
+
+        typename KargerStein::Multigraph multigraph {static_cast<vertex_t>(graph.size()), {}};
+        for (vertex_t u = 0; u < graph.size(); ++u) {
+            for_each_neighbor(graph, u, [&](const auto& edge) {
+                if (u < edge.end) {
+                    multigraph.edges.push_back(edge);
+                }
+            });
+        }
+
+        if (n_trials == 0) {
+            auto log_n = std::log(static_cast<double>(graph.size()));
+            n_trials = std::max(1u, static_cast<unsigned>(std::ceil(log_n * log_n)));
+        }
+        if (n_threads == 0) {
+            n_threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        n_threads = std::min(n_threads, n_trials);
+
+        // the best cut, and the first trial which found it
+        typename KargerStein::Cut best {edge_t<weight_lt>::D_INFINITY, {}};
+        unsigned best_trial = 0;
+        std::mutex best_mutex;
+        std::atomic<unsigned> next_trial = 0;
+        auto worker = [&] {
+            for (auto trial = next_trial++; trial < n_trials; trial = next_trial++) {
+                std::mt19937_64 rng(seed + trial);
+                auto cut = KargerStein::run(multigraph, rng);
+                std::lock_guard lock(best_mutex);
+                if (cut.first < best.first || (cut.first == best.first && trial < best_trial)) {
+                    best = std::move(cut);
+                    best_trial = trial;
+                }
+            }
+        };
+        {
+            std::vector<std::jthread> threads;
+            threads.reserve(n_threads - 1);
+            for (unsigned t = 1; t < n_threads; ++t) {
+                threads.emplace_back(worker);
+            }
+            worker();
+        }
+        return internal::make_cut(graph, best.second);
+    }
+
+    //==============================================================================
+    // Graphs
+    //==============================================================================
+
+    /**
+     * @brief The result of the minimum cut algorithms on a graph
+     */
+    template <VertexKey Vertex, Number weight_t>
+    struct MinimumCut {
+        // the sum of the weights of the cut edges
+        weight_t value;
+        // one side of the cut (the source side for a s-t cut)
+        std::vector<Vertex> vertices;
+        // the edges from the vertices of this side to the other side
+        std::vector<EdgeDefinition<Vertex, weight_t>> edges;
+    };
+
+    namespace internal {
+        template <typename Impl, VertexKey Vertex, bool IsDirected>
+        MinimumCut<Vertex, typename Impl::weight_lt> make_cut(
+            const Graph<Impl, Vertex, IsDirected, typename Impl::weight_lt>& graph,
+            const MinimumCutImpl<typename Impl::weight_lt>& cut
+        ) {
+            MinimumCut<Vertex, typename Impl::weight_lt> res {cut.value, {}, {}};
+            for (auto v : cut.vertices) {
+                res.vertices.push_back(graph.get_vertex_from_internal_index(v));
+            }
+            for (const auto& edge : cut.edges) {
+                res.edges.push_back({
+                    .start = graph.get_vertex_from_internal_index(edge.start),
+                    .end = graph.get_vertex_from_internal_index(edge.end),
+                    .weight = edge.weight
+                });
+            }
+            return res;
+        }
+    } // namespace internal
+
+    /**
+     * @brief Compute a minimum cut between two vertices
+     * @see minimum_cut(const G&, vertex_t, vertex_t)
+     */
+    template <typename Impl, VertexKey Vertex, bool directed>
+    requires GraphImpl<Impl, typename Impl::weight_lt>
+    MinimumCut<Vertex, typename Impl::weight_lt> minimum_cut(
+        const Graph<Impl, Vertex, directed, typename Impl::weight_lt>& graph,
+        const Vertex& source,
+        const Vertex& sink
+    ) {
+        assert(graph.get_internal_index(source) != INVALID_VERTEX && graph.get_internal_index(sink) != INVALID_VERTEX);
+        auto cut = minimum_cut(graph.impl(), graph.get_internal_index(source), graph.get_internal_index(sink));
+        return internal::make_cut(graph, cut);
+    }
+
+    /**
+     * @brief Compute a global minimum cut of an undirected graph
+     * @see minimum_cut_stoer_wagner(const G&)
+     */
+    template <typename Impl, VertexKey Vertex>
+    requires GraphImpl<Impl, typename Impl::weight_lt>
+    MinimumCut<Vertex, typename Impl::weight_lt> minimum_cut_stoer_wagner(
+        const Graph<Impl, Vertex, false, typename Impl::weight_lt>& graph
+    ) {
+        return internal::make_cut(graph, minimum_cut_stoer_wagner(graph.impl()));
+    }
+
+    template <typename Impl, VertexKey Vertex>
+    requires GraphImpl<Impl, typename Impl::weight_lt>
+    MinimumCut<Vertex, typename Impl::weight_lt> minimum_cut_stoer_wagner(
+        const Graph<Impl, Vertex, true, typename Impl::weight_lt>& graph
+    ) {
+        static_assert(false, "The global minimum cut works only on undirected graphs");
+    }
+
+    /**
+     * @brief Compute a global minimum cut of an undirected graph, with a high probability
+     * @see minimum_cut_karger_stein(const G&, unsigned, unsigned, std::uint64_t)
+     */
+    template <typename Impl, VertexKey Vertex>
+    requires GraphImpl<Impl, typename Impl::weight_lt>
+    MinimumCut<Vertex, typename Impl::weight_lt> minimum_cut_karger_stein(
+        const Graph<Impl, Vertex, false, typename Impl::weight_lt>& graph,
+        unsigned n_trials = 0,
+        unsigned n_threads = 0,
+        std::uint64_t seed = 0
+    ) {
+        return internal::make_cut(graph, minimum_cut_karger_stein(graph.impl(), n_trials, n_threads, seed));
+    }
+
+    template <typename Impl, VertexKey Vertex>
+    requires GraphImpl<Impl, typename Impl::weight_lt>
+    MinimumCut<Vertex, typename Impl::weight_lt> minimum_cut_karger_stein(
+        const Graph<Impl, Vertex, true, typename Impl::weight_lt>& graph,
+        unsigned n_trials = 0,
+        unsigned n_threads = 0,
+        std::uint64_t seed = 0
+    ) {
+        static_assert(false, "The global minimum cut works only on undirected graphs");
+    }
+} // namespace grafology
@@ -36,6 +36,10 @@ namespace grafology {
         for (const auto& edge: edges) {
             if (disjoint_set.merge(edge.start, edge.end)) {
                 res.set_edge(edge);
+                // the tree is complete, the remaining edges would only make cycles
+                if (disjoint_set.count() == 1) {
+                    break;
+                }
             }
         }
         return res;
@@ -1,7 +1,10 @@
 #pragma once
 #include <functional>
-#include <queue>
+#include <limits>
+#include <optional>
+#include <type_traits>
 #include "requirements.h"
+#include "../indexed_heap.h"
 
 namespace grafology {
   /**
@@ -49,10 +52,26 @@ namespace grafology {
     }
   };
 
+  namespace internal {
+    /** @brief true if a cost function returned its maximum value (or infinity) */
+    template <typename cost_t>
+    bool is_infinite_cost(cost_t cost) {
+      if (cost == std::numeric_limits<cost_t>::max()) {
+        return true;
+      }
+      if constexpr (std::numeric_limits<cost_t>::has_infinity) {
+        return cost == std::numeric_limits<cost_t>::infinity();
+      }
+      return false;
+    }
+  }  // namespace internal
+
   /**
    * @brief Compute the shortest path from one vertex to another
    * @return a vector of tuples (vertex, distance from start)
-   * @remark this is based on the A* algorithm
+   * @remark this is based on the A* algorithm: the vertices are visited by increasing
+   * (distance from start + f(vertex, end)). So f must never overestimate the distance to end.
+   * f can return its maximum value (e.g. D_INFINITY) for the vertices which cannot reach end.
    * 
    * @tparam Graph The graph type
    * @tparam F The cost function type
@@ -69,39 +88,287 @@ namespace grafology {
 
     assert(start < graph.size() && end < graph.size());
     const auto n_vertices = graph.size();
-    using cost_type = decltype(f(start, end));
-    std::priority_queue<std::pair<cost_type, vertex_t>> pq;
+    using cost_type = decltype(std::declval<weight_lt>() + f(start, end));
+    IndexedDAryHeap<cost_type> heap(n_vertices);
     ShortestPathsImpl<weight_lt> res(n_vertices, end);
     std::vector<bool> visited(n_vertices, false);
 
+    // the priority of a vertex is the distance from start + the estimated distance to end
+    // an infinite estimation means that the end cannot be reached from the vertex
+    auto push = [&](vertex_t v, weight_lt d) {
+      auto h = f(v, end);
+      if (internal::is_infinite_cost(h)) {
+        return;
+      }
+      heap.push_or_decrease(v, d + h);
+    };
+
     res._distances[start] = 0;
-    pq.push({f(start, end), start});
-    while (!pq.empty()) {
-      auto [_, v] = pq.top();
-      pq.pop();
+    push(start, 0);
+    while (!heap.empty()) {
+      auto v = heap.pop().vertex;
       if (v == end) {
         return res;
       }
       auto d = res._distances[v];
       visited[v] = true;
-      for (const auto& edge : graph.get_neighbors(v)) {
+      for_each_neighbor(graph, v, [&](const auto& edge) {
         if (edge.weight <= 0) {
           throw error("Shortest path: negative weights are not allowed");
         }
         if (visited[edge.end]) {
-          continue;
+          return;
         }
         auto new_d = d + edge.weight;
         if (new_d < res._distances[edge.end]) {
           res._distances[edge.end] = new_d;
           res._predecessors[edge.end] = v;
-          pq.push({f(edge.end, end), edge.end});
+          push(edge.end, new_d);
         }
-      }
+      });
     }
     return {n_vertices, end};
   }
 
+  namespace internal {
+    /**
+     * @brief The potential of the bidirectional Dijkstra's algorithm: all the vertices have the same one
+     */
+    template <typename weight_t>
+    struct ZeroPotential {
+      using key_type = weight_t;
+      using heap_type = typename DijkstraHeap<weight_t>::type;
+      static constexpr key_type SCALE = 1;
+
+      std::optional<key_type> operator()(vertex_t) const { return key_type{0}; }
+    };
+
+    /**
+     * @brief The potential of the bidirectional A* algorithm
+     * @details The forward search uses p(v) = (f(v, end) - f(start, v)) / 2 and the backward search -p(v).
+     * As the two potentials sum to 0, an edge has the same reduced weight in both searches and they can be
+     * stopped like the bidirectional Dijkstra's algorithm. The keys are doubled (SCALE) to avoid dividing
+     * the costs by 2. A vertex for which f is infinite cannot be on a path from start to end: it has no potential.
+     */
+    template <typename weight_t, typename F>
+    struct AveragePotential {
+      using cost_type = std::invoke_result_t<F&, vertex_t, vertex_t>;
+      using key_type = decltype(std::declval<weight_t>() + std::declval<cost_type>());
+      using heap_type = IndexedDAryHeap<key_type>;
+      static constexpr key_type SCALE = 2;
+      static_assert(std::is_signed_v<key_type>, "The bidirectional A* algorithm requires signed costs");
+
+      std::optional<key_type> operator()(vertex_t v) const {
+        auto to_end = f(v, end);
+        auto from_start = f(start, v);
+        if (is_infinite_cost(to_end) || is_infinite_cost(from_start)) {
+          return std::nullopt;
+        }
+        return static_cast<key_type>(to_end) - static_cast<key_type>(from_start);
+      }
+
+      F& f;
+      vertex_t start;
+      vertex_t end;
+    };
+
+    /**
+     * @brief The search shared by the bidirectional shortest path algorithms
+     * @details A search from start on the graph and a search from end on the inverted graph are run
+     * alternately (the one with the smallest queue is advanced). Each time an edge reaches a vertex
+     * known by the other search, a path is found. The searches are stopped as soon as the sum of the keys
+     * they have popped is greater than the shortest path found: the remaining paths can't be shorter.
+     * @param for_each_out call f(neighbor, weight) for each out-neighbor of a vertex
+     * @param for_each_in call f(neighbor, weight) for each in-neighbor of a vertex
+     */
+    template <typename weight_t, typename Out, typename In, typename Potential>
+    ShortestPathsImpl<weight_t> bidirectional_search(
+        std::size_t n_vertices,
+        Out&& for_each_out,
+        In&& for_each_in,
+        vertex_t start,
+        vertex_t end,
+        const Potential& potential
+    ) {
+      using key_type = typename Potential::key_type;
+      static constexpr auto D_INFINITY = edge_t<weight_t>::D_INFINITY;
+
+      assert(start < n_vertices && end < n_vertices);
+      ShortestPathsImpl<weight_t> res(n_vertices, end);
+      if (start == end) {
+        res._distances[start] = 0;
+        return res;
+      }
+      auto start_potential = potential(start);
+      auto end_potential = potential(end);
+      if (!start_potential || !end_potential) {
+        return res;
+      }
+
+      struct Search {
+        Search(std::size_t n_vertices)
+            : distances(n_vertices, D_INFINITY)
+            , predecessors(n_vertices, NO_PREDECESSOR)
+            , heap(n_vertices) {}
+
+        std::vector<weight_t> distances;
+        // for the backward search, the next vertex on the path to end
+        std::vector<vertex_t> predecessors;
+        typename Potential::heap_type heap;
+        key_type last_key {};
+      };
+      Search forward(n_vertices);
+      Search backward(n_vertices);
+      forward.distances[start] = 0;
+      forward.last_key = *start_potential;
+      forward.heap.push(start, forward.last_key);
+      backward.distances[end] = 0;
+      backward.last_key = -*end_potential;
+      backward.heap.push(end, backward.last_key);
+
+      // the length of the shortest path found and the vertex where the two searches met
+      weight_t best = D_INFINITY;
+      vertex_t meeting = INVALID_VERTEX;
+
+      auto scan = [&](Search& search, const Search& other, vertex_t u, auto&& for_each, bool is_forward) {
+        auto d = search.distances[u];
+        for_each(u, [&](vertex_t v, weight_t weight) {
+          if (weight <= 0) {
+            throw error("Shortest path: negative weights are not allowed");
+          }
+          auto new_d = d + weight;
+          if (!(new_d < search.distances[v])) {
+            return;
+          }
+          auto p = potential(v);
+          if (!p) {
+            return;
+          }
+          search.distances[v] = new_d;
+          search.predecessors[v] = u;
+          auto key = Potential::SCALE * static_cast<key_type>(new_d);
+          search.heap.push_or_decrease(v, is_forward ? key + *p : key - *p);
+          if (other.distances[v] != D_INFINITY && new_d + other.distances[v] < best) {
+            best = new_d + other.distances[v];
+            meeting = v;
+          }
+        });
+      };
+
+      while (!forward.heap.empty() && !backward.heap.empty()) {
+        bool is_forward = forward.heap.size() <= backward.heap.size();
+        auto& search = is_forward ? forward : backward;
+        auto [key, u] = search.heap.pop();
+        search.last_key = key;
+        // the popped keys are lower bounds of the keys still queued
+        if (best != D_INFINITY && !(forward.last_key + backward.last_key < Potential::SCALE * static_cast<key_type>(best))) {
+          break;
+        }
+        if (is_forward) {
+          scan(forward, backward, u, for_each_out, true);
+        } else {
+          scan(backward, forward, u, for_each_in, false);
+        }
+      }
+      if (best == D_INFINITY) {
+        return res;
+      }
+
+      // the path from start to the meeting vertex is given by the forward search
+      // and the path from the meeting vertex to end by the backward search
+      res._distances = std::move(forward.distances);
+      res._predecessors = std::move(forward.predecessors);
+      for (auto v = meeting; v != end;) {
+        auto next = backward.predecessors[v];
+        res._predecessors[next] = v;
+        res._distances[next] = best - backward.distances[next];
+        v = next;
+      }
+      return res;
+    }
+
+    template <typename Graph>
+    auto out_neighbors(const Graph& graph) {
+      return [&graph](vertex_t v, auto&& f) {
+        for_each_neighbor(graph, v, [&](const auto& edge) { f(edge.end, edge.weight); });
+      };
+    }
+
+    template <typename Graph>
+    auto in_neighbors(const Graph& graph) {
+      return [&graph](vertex_t v, auto&& f) {
+        for_each_in_neighbor(graph, v, [&](const auto& edge) { f(edge.start, edge.weight); });
+      };
+    }
+  }  // namespace internal
+
+  /**
+   * @brief Compute the shortest path from one vertex to another with a bidirectional Dijkstra's algorithm
+   * @details A search from start and a search from end (on the in-neighbors) are run until they meet.
+   * For a point-to-point query, each search only explores the vertices about half as far as the one-way
+   * search, which is much less vertices on large graphs.
+   * @remark the in-neighbors must be cheap to visit: for the directed implementations which don't keep
+   * the in-edges (e.g. SparseGraphImpl by default), use the overload with the inverted graph.
+   * @return the same result as shortest_path() (only the distances along the path are set)
+   */
+  template <typename Graph>
+  requires GraphImpl<Graph, typename Graph::weight_lt>
+  ShortestPathsImpl<typename Graph::weight_lt> bidirectional_shortest_path(const Graph& graph, vertex_t start, vertex_t end) {
+    using weight_lt = typename Graph::weight_lt;
+    return internal::bidirectional_search<weight_lt>(
+        graph.size(), internal::out_neighbors(graph), internal::in_neighbors(graph), start, end,
+        internal::ZeroPotential<weight_lt>{}
+    );
+  }
+
+  /**
+   * @brief Compute the shortest path from one vertex to another with a bidirectional Dijkstra's algorithm
+   * @param inverted the inverted graph (i.e. graph.invert()) which is used for the search from end
+   */
+  template <typename Graph>
+  requires GraphImpl<Graph, typename Graph::weight_lt>
+  ShortestPathsImpl<typename Graph::weight_lt> bidirectional_shortest_path(const Graph& graph, const Graph& inverted, vertex_t start, vertex_t end) {
+    using weight_lt = typename Graph::weight_lt;
+    assert(graph.size() == inverted.size());
+    return internal::bidirectional_search<weight_lt>(
+        graph.size(), internal::out_neighbors(graph), internal::out_neighbors(inverted), start, end,
+        internal::ZeroPotential<weight_lt>{}
+    );
+  }
+
+  /**
+   * @brief Compute the shortest path from one vertex to another with a bidirectional A* algorithm
+   * @details Like the bidirectional Dijkstra's algorithm, but the searches are guided by f: the search
+   * from start by f(v, end) and the search from end by f(start, v).
+   * @remark f must be consistent, i.e. f(u, w) <= weight(u, v) + f(v, w) and f(w, v) <= f(w, u) + weight(u, v)
+   * (e.g. a distance as the crow flies), otherwise the path may not be the shortest one.
+   * f can return its maximum value (e.g. D_INFINITY) for the vertices which cannot be on a path.
+   */
+  template <typename Graph, PathCostFunctionImpl F>
+  requires GraphImpl<Graph, typename Graph::weight_lt>
+  ShortestPathsImpl<typename Graph::weight_lt> bidirectional_shortest_path(const Graph& graph, vertex_t start, vertex_t end, F& f) {
+    using weight_lt = typename Graph::weight_lt;
+    return internal::bidirectional_search<weight_lt>(
+        graph.size(), internal::out_neighbors(graph), internal::in_neighbors(graph), start, end,
+        internal::AveragePotential<weight_lt, F>{f, start, end}
+    );
+  }
+
+  /**
+   * @brief Compute the shortest path from one vertex to another with a bidirectional A* algorithm
+   * @param inverted the inverted graph (i.e. graph.invert()) which is used for the search from end
+   */
+  template <typename Graph, PathCostFunctionImpl F>
+  requires GraphImpl<Graph, typename Graph::weight_lt>
+  ShortestPathsImpl<typename Graph::weight_lt> bidirectional_shortest_path(const Graph& graph, const Graph& inverted, vertex_t start, vertex_t end, F& f) {
+    using weight_lt = typename Graph::weight_lt;
+    assert(graph.size() == inverted.size());
+    return internal::bidirectional_search<weight_lt>(
+        graph.size(), internal::out_neighbors(graph), internal::out_neighbors(inverted), start, end,
+        internal::AveragePotential<weight_lt, F>{f, start, end}
+    );
+  }
+
   /**
    * @brief This struct allows to process the results of the algorithm all_shortest_paths
    * @remark it allows to save the results of the algorithm and so avoid to use dangling references
@@ -164,4 +431,62 @@ namespace grafology {
     return ShortestPaths<Impl, Vertex, directed>(std::move(sp_impl), graph);
   }
 
+  /**
+   * @brief Compute the shortest path from one vertex to another with a bidirectional Dijkstra's algorithm
+   * @return a range of tuples (vertex, distance from start)
+   * @see bidirectional_shortest_path(const Graph&, vertex_t, vertex_t)
+   */
+  template <typename Impl, VertexKey Vertex, bool directed>
+  requires GraphImpl<Impl, typename Impl::weight_lt>
+  ShortestPaths<Impl, Vertex, directed> bidirectional_shortest_path(const Graph<Impl, Vertex, directed, typename Impl::weight_lt>& graph, const Vertex& start, const Vertex& end) {
+    assert(graph.get_internal_index(start) != INVALID_VERTEX && graph.get_internal_index(end)  != INVALID_VERTEX);
+    auto sp_impl = bidirectional_shortest_path(graph.impl(), graph.get_internal_index(start), graph.get_internal_index(end));
+    return ShortestPaths<Impl, Vertex, directed>(std::move(sp_impl), graph);
+  }
+
+  /**
+   * @brief Compute the shortest path from one vertex to another with a bidirectional Dijkstra's algorithm
+   * @param inverted the inverted graph (i.e. graph.invert()) which is used for the search from end
+   */
+  template <typename Impl, VertexKey Vertex, bool directed>
+  requires GraphImpl<Impl, typename Impl::weight_lt>
+  ShortestPaths<Impl, Vertex, directed> bidirectional_shortest_path(const Graph<Impl, Vertex, directed, typename Impl::weight_lt>& graph, const Graph<Impl, Vertex, directed, typename Impl::weight_lt>& inverted, const Vertex& start, const Vertex& end) {
+    assert(graph.get_internal_index(start) != INVALID_VERTEX && graph.get_internal_index(end)  != INVALID_VERTEX);
+    auto sp_impl = bidirectional_shortest_path(graph.impl(), inverted.impl(), graph.get_internal_index(start), graph.get_internal_index(end));
+    return ShortestPaths<Impl, Vertex, directed>(std::move(sp_impl), graph);
+  }
+
+  /**
+   * @brief Compute the shortest path from one vertex to another with a bidirectional A* algorithm
+   * @return a range of tuples (vertex, distance from start)
+   * @see bidirectional_shortest_path(const Graph&, vertex_t, vertex_t, F&)
+   */
+  template <typename Impl, VertexKey Vertex, bool directed, PathCostFunction<Vertex> F>
+  requires GraphImpl<Impl, typename Impl::weight_lt>
+  ShortestPaths<Impl, Vertex, directed> bidirectional_shortest_path(const Graph<Impl, Vertex, directed, typename Impl::weight_lt>& graph, const Vertex& start, const Vertex& end, F& f) {
+    auto cost_function = [&] (vertex_t u, vertex_t v) {
+      assert(u < graph.size() && v < graph.size());
+      return f(graph.get_vertex_from_internal_index(u), graph.get_vertex_from_internal_index(v));
+    };
+    assert(graph.get_internal_index(start) != INVALID_VERTEX && graph.get_internal_index(end)  != INVALID_VERTEX);
+    auto sp_impl = bidirectional_shortest_path(graph.impl(), graph.get_internal_index(start), graph.get_internal_index(end), cost_function);
+    return ShortestPaths<Impl, Vertex, directed>(std::move(sp_impl), graph);
+  }
+
+  /**
+   * @brief Compute the shortest path from one vertex to another with a bidirectional A* algorithm
+   * @param inverted the inverted graph (i.e. graph.invert()) which is used for the search from end
+   */
+  template <typename Impl, VertexKey Vertex, bool directed, PathCostFunction<Vertex> F>
+  requires GraphImpl<Impl, typename Impl::weight_lt>
+  ShortestPaths<Impl, Vertex, directed> bidirectional_shortest_path(const Graph<Impl, Vertex, directed, typename Impl::weight_lt>& graph, const Graph<Impl, Vertex, directed, typename Impl::weight_lt>& inverted, const Vertex& start, const Vertex& end, F& f) {
+    auto cost_function = [&] (vertex_t u, vertex_t v) {
+      assert(u < graph.size() && v < graph.size());
+      return f(graph.get_vertex_from_internal_index(u), graph.get_vertex_from_internal_index(v));
+    };
+    assert(graph.get_internal_index(start) != INVALID_VERTEX && graph.get_internal_index(end)  != INVALID_VERTEX);
+    auto sp_impl = bidirectional_shortest_path(graph.impl(), inverted.impl(), graph.get_internal_index(start), graph.get_internal_index(end), cost_function);
+    return ShortestPaths<Impl, Vertex, directed>(std::move(sp_impl), graph);
+  }
+
 }  // namespace grafology
@@ -1,6 +1,7 @@
 #pragma once
 #include "../graph.h"
 #include <stack>
+#include <tuple>
 
 namespace grafology {
     template <typename G>
@@ -14,7 +15,6 @@ namespace grafology {
         std::vector<int> discovery_time(V, UNDEFINED);
         std::vector<int> lowest_time(V, UNDEFINED);
         std::vector<bool> stack_member(V, false);
-        std::vector<vertex_t> parent(V, NO_PREDECESSOR);
         int time = 0;
 
         for (int u = 0; u < V; ++u) {
@@ -25,16 +25,18 @@ namespace grafology {
                 // - continue the DFS
                 // - post-process the node (update the lowest time of the parent and check if we have a cycle)
                 // So when a node need to be processed, one pushes on the stack:
-                //    (node, pre-process=False)
-                //    (node, pre-process=True)
+                //    (node, parent, pre-process=False)
+                //    (node, parent, pre-process=True)
                 // the first pushed value will only be used when the DFS from node is finished
-                std::stack<std::pair<vertex_t, bool>> stack;
+                // NB: a node can be pushed several times before being visited, so its parent is stored
+                // with it on the stack.
+                std::stack<std::tuple<vertex_t, vertex_t, bool>> stack;
                 std::stack<vertex_t> dfs_stack;
                 
-                stack.push({u, false});
-                stack.push({u, true});
+                stack.push({u, NO_PREDECESSOR, false});
+                stack.push({u, NO_PREDECESSOR, true});
                 while (!stack.empty()) {
-                    auto [v, pre_process] = stack.top();
+                    auto [v, p, pre_process] = stack.top();
                     stack.pop();
                     if (pre_process) {
                         if (discovery_time[v] == UNDEFINED) {
@@ -42,20 +44,26 @@ namespace grafology {
                             stack_member[v] = true;
                             discovery_time[v] = lowest_time[v] = time;
                             ++time;
-                            for (auto w : graph.get_raw_neighbors(v)) {
+                            for_each_neighbor(graph, v, [&](const auto& edge) {
+                                auto w = edge.end;
                                 if (discovery_time[w] == UNDEFINED)  {
-                                    parent[w] = v;
-                                    stack.push({w, false});
-                                    stack.push({w, true});
+                                    stack.push({w, v, false});
+                                    stack.push({w, v, true});
                                 } else if (stack_member[w]) {
                                     /// it's a back edge
                                     lowest_time[v] = std::min(lowest_time[v], discovery_time[w]);
                                 }
+                            });
+                        } else {
+                            // the node has been visited through another path since it was pushed:
+                            // the edge (p, v) is handled as a back edge and the post-processing is skipped
+                            if (stack_member[v]) {
+                                lowest_time[p] = std::min(lowest_time[p], discovery_time[v]);
                             }
+                            stack.pop();
                         }
                     } else {
                         // update the parent
-                        auto p = parent[v];
                         if (p != NO_PREDECESSOR) {
                             //  Check if the subtree rooted with u has a connection to one of the ancestors of p
                             lowest_time[p] = std::min(lowest_time[p], lowest_time[v]);
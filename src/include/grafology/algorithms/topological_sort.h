@@ -44,9 +44,9 @@ namespace grafology {
                 co_yield std::make_pair(i_group, vertex);
                 ++n_processed;
                 in_degrees[vertex] = -1;
-                for (auto neighbour : graph.get_raw_neighbors(vertex)) {
-                    --in_degrees[neighbour];
-                }
+                for_each_neighbor(graph, vertex, [&](const auto& edge) {
+                    --in_degrees[edge.end];
+                });
             }
             ++i_group;
         }
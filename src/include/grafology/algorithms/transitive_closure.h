@@ -1,33 +1,270 @@
 #pragma once
 #include "../graph.h"
+#include "strongly_connected_components.h"
+#include <algorithm>
+#include <barrier>
+#include <bit>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <vector>
 
 namespace grafology {
+    namespace internal {
+        /**
+         * @brief A square matrix of bits stored as rows of 64 bits words
+         * @details It is used for computing the reachability between vertices (or components)
+         * so that whole rows can be OR-ed at once.
+         */
+        class BitMatrix {
+        public:
+            using word_t = std::uint64_t;
+            static constexpr unsigned WORD_BITS = 64;
+
+            explicit BitMatrix(std::size_t n) :
+              _n(n),
+              _n_words((n + WORD_BITS - 1) / WORD_BITS),
+              _words(n * _n_words, 0) {}
+
+            std::size_t size() const { return _n; }
+
+            std::size_t n_words() const { return _n_words; }
+
+            word_t* row(std::size_t i) { return _words.data() + i * _n_words; }
+
+            const word_t* row(std::size_t i) const { return _words.data() + i * _n_words; }
+
+            bool test(std::size_t i, std::size_t j) const {
+                return (row(i)[j / WORD_BITS] >> (j % WORD_BITS)) & 1;
+            }
+
+            void set(std::size_t i, std::size_t j) {
+                row(i)[j / WORD_BITS] |= word_t{1} << (j % WORD_BITS);
+            }
+
+            /** @brief row i |= other. The loop is simple enough to be vectorised by the compiler */
+            void or_row(std::size_t i, const word_t* other) {
+                auto r = row(i);
+                for (std::size_t w = 0; w < _n_words; ++w) {
+                    r[w] |= other[w];
+                }
+            }
+
+            /** @brief call f(j) for each bit j set in the row i */
+            template<typename F>
+            void for_each_bit(std::size_t i, F&& f) const {
+                auto r = row(i);
+                for (std::size_t w = 0; w < _n_words; ++w) {
+                    for (auto word = r[w]; word != 0; word &= word - 1) {
+                        f(w * WORD_BITS + std::countr_zero(word));
+                    }
+                }
+            }
+
+        private:
+            std::size_t _n;
+            std::size_t _n_words;
+            std::vector<word_t> _words;
+        };
+
+        /** @brief true if the implementation uses an adjacency matrix */
+        template<typename G>
+        struct is_adjacency_matrix : std::false_type {};
+
+        template<Number weight_t>
+        struct is_adjacency_matrix<DenseGraphImpl<weight_t>> : std::true_type {};
+
+        template<Number weight_t>
+        struct is_adjacency_matrix<BitDenseGraphImpl<weight_t>> : std::true_type {};
+
+        /** @brief below this number of rows per thread, the synchronisation costs more than it saves */
+        static constexpr std::size_t MIN_CLOSURE_ROWS_PER_THREAD = 256;
+
+        /** @brief The adjacency matrix of a graph as bits (including the self-loops) */
+        template <typename G>
+        BitMatrix get_adjacency_bits(const G& graph) {
+            const auto n_vertices = graph.size();
+            BitMatrix m(n_vertices);
+            for (vertex_t i = 0; i < n_vertices; ++i) {
+                if constexpr (requires { graph.get_row(i); }) {
+                    std::ranges::copy(graph.get_row(i), m.row(i));
+                } else {
+                    for_each_neighbor(graph, i, [&](const auto& edge) { m.set(i, edge.end); });
+                    if (graph.has_edge(i, i)) {
+                        m.set(i, i);
+                    }
+                }
+            }
+            return m;
+        }
+
+        /**
+         * @brief Warshall's algorithm on the rows of a bit matrix
+         * @details For each k, the row k is OR-ed into each row i which has the bit k.
+         * The rows are split in contiguous blocks between the threads, which are synchronised
+         * after each k. A thread only writes its own rows and the row k is never written
+         * during the step k, so no lock is needed.
+         */
+        inline void warshall_closure(BitMatrix& m, unsigned n_threads) {
+            const auto n = m.size();
+            auto process = [&m](std::size_t first, std::size_t last, std::size_t k) {
+                const auto row_k = m.row(k);
+                for (std::size_t i = first; i < last; ++i) {
+                    if (i != k && m.test(i, k)) {
+                        m.or_row(i, row_k);
+                    }
+                }
+            };
+
+            n_threads = std::min<std::size_t>(n_threads, n / MIN_CLOSURE_ROWS_PER_THREAD);
+            if (n_threads <= 1) {
+                for (std::size_t k = 0; k < n; ++k) {
+                    process(0, n, k);
+                }
+                return;
+            }
+            // the barrier must outlive the threads (which are joined in the vector destructor)
+            std::barrier sync(n_threads);
+            std::vector<std::jthread> threads;
+            threads.reserve(n_threads);
+            for (unsigned t = 0; t < n_threads; ++t) {
+                threads.emplace_back([&, first = n * t / n_threads, last = n * (t + 1) / n_threads] {
+                    for (std::size_t k = 0; k < n; ++k) {
+                        process(first, last, k);
+                        sync.arrive_and_wait();
+                    }
+                });
+            }
+        }
+
+        /**
+         * @brief The reachability between the (strongly) connected components of a graph
+         * @details Components are numbered in reverse topological order, so when a component is
+         * processed, the components it reaches are already closed: its row is the OR of their rows.
+         * A component reaches itself if it has more than one vertex or a self-loop.
+         * @param component the component of each vertex (output)
+         * @param components the vertices of each component (output)
+         */
+        template <typename G>
+        BitMatrix condensed_closure(const G& graph, std::vector<vertex_t>& component, std::vector<std::vector<vertex_t>>& components) {
+            const auto n_vertices = graph.size();
+            component.assign(n_vertices, NO_PREDECESSOR);
+            components.clear();
+            if (graph.is_directed()) {
+                // Tarjan's algorithm yields the components in reverse topological order
+                for (auto&& scc : strongly_connected_components(graph)) {
+                    for (auto v : scc) {
+                        component[v] = components.size();
+                    }
+                    components.push_back(std::move(scc));
+                }
+            } else {
+                // the components of an undirected graph are not linked to each other
+                std::vector<vertex_t> stack;
+                for (vertex_t u = 0; u < n_vertices; ++u) {
+                    if (component[u] != NO_PREDECESSOR) {
+                        continue;
+                    }
+                    auto& members = components.emplace_back();
+                    component[u] = components.size() - 1;
+                    stack.push_back(u);
+                    while (!stack.empty()) {
+                        auto v = stack.back();
+                        stack.pop_back();
+                        members.push_back(v);
+                        for_each_neighbor(graph, v, [&](const auto& edge) {
+                            if (component[edge.end] == NO_PREDECESSOR) {
+                                component[edge.end] = component[u];
+                                stack.push_back(edge.end);
+                            }
+                        });
+                    }
+                }
+            }
+
+            BitMatrix reach(components.size());
+            for (std::size_t c = 0; c < components.size(); ++c) {
+                const auto& members = components[c];
+                for (auto v : members) {
+                    for_each_neighbor(graph, v, [&](const auto& edge) {
+                        auto d = component[edge.end];
+                        // if d is already reached, everything it reaches is already there too
+                        if (d != c && !reach.test(c, d)) {
+                            reach.set(c, d);
+                            reach.or_row(c, reach.row(d));
+                        }
+                    });
+                }
+                if (members.size() > 1 || graph.has_edge(members.front(), members.front())) {
+                    reach.set(c, c);
+                }
+            }
+            return reach;
+        }
+
+        /** @brief The edges to add to a graph for closing it from the reachability of its components */
+        template <typename G>
+        generator<typename G::edge_lt> get_closure_edges(
+            const G& graph, 
+            const BitMatrix& reach, 
+            const std::vector<vertex_t>& component, 
+            const std::vector<std::vector<vertex_t>>& components
+        ) {
+            const bool is_directed = graph.is_directed();
+            std::vector<typename G::edge_lt> row;
+            for (vertex_t i = 0; i < graph.size(); ++i) {
+                row.clear();
+                reach.for_each_bit(component[i], [&](std::size_t d) {
+                    for (auto j : components[d]) {
+                        if ((is_directed || i <= j) && !graph.has_edge(i, j)) {
+                            row.push_back({.start = i, .end = j, .weight = 1});
+                        }
+                    }
+                });
+                for (const auto& edge : row) {
+                    co_yield edge;
+                }
+            }
+        }
+    } // namespace internal
+
     /**
      * @brief Compute the transitive closure of a graph
      * @tparam G the type of the graph
+     * @param n_threads the maximum number of threads used for the adjacency matrices (0 for the hardware concurrency)
      * @details The transitive closure of a graph is a graph which will add an edge from vertex i to vertex j if they are indirectly linked
      * So that if there is a path from i to j, and there is an edge from j to k, there will be an edge from i to k
-     * @remark The algorithm is derived from the Warshall algorithm. 
-     * @remark Its complexity is O(n^3) where n is the number of vertices for a densely connected graph 
-     * but tends to O(n^2) as the graph becomes sparser.
+     * The added edges have a weight of 1, the existing edges are left untouched.
+     * @remark For the implementations using an adjacency matrix, the algorithm is derived from the Warshall algorithm
+     * and works on rows of bits: its complexity is O(n^3/64) and the rows are processed by several threads.
+     * @remark For the other implementations, the (strongly) connected components are condensed first and
+     * the closure of the resulting DAG is computed in topological order: its complexity is O(c.e/64) where c is the
+     * number of components and e the number of edges.
      */
-    // TODO: should we put directly this code in the graph class? Especially when using an adjacency matrix?
-    // TODO: investigate the use of symmetry for undirected graphs
-    // TODO: investigate faster algorithms
     template <typename G>
     requires GraphImpl<G, typename G::weight_lt>
-    void transitive_closure(G& graph) {
+    void transitive_closure(G& graph, unsigned n_threads = 0) {
         const auto n_vertices = graph.size();
-        for (vertex_t k = 0; k < n_vertices; ++k) {
+        const bool is_directed = graph.is_directed();
+
+        if constexpr (internal::is_adjacency_matrix<G>::value) {
+            auto reach = internal::get_adjacency_bits(graph);
+            internal::warshall_closure(reach, n_threads == 0 ? std::thread::hardware_concurrency() : n_threads);
+            // set_edge() is O(1) on an adjacency matrix, there is no need to batch the edges
             for (vertex_t i = 0; i < n_vertices; ++i) {
-                if (graph.has_edge(i, k)) {
-                    for (vertex_t j = 0; j < n_vertices; ++j) {
-                        if (graph.has_edge(k, j)) {
-                            graph.set_edge(i, j, 1);
-                        }
+                reach.for_each_bit(i, [&](vertex_t j) {
+                    if ((is_directed || i <= j) && !graph.has_edge(i, j)) {
+                        graph.set_edge(i, j, 1);
                     }
-                }
+                });
             }
+        } else {
+            std::vector<vertex_t> component;
+            std::vector<std::vector<vertex_t>> components;
+            auto reach = internal::condensed_closure(graph, component, components);
+            // the edges are loaded in a single batch
+            auto new_edges = internal::get_closure_edges(graph, reach, component, components);
+            graph.set_edges(new_edges);
         }
     }
 
@@ -36,21 +273,20 @@ namespace grafology {
      * @tparam Impl the type of the graph implementation
      * @tparam Vertex the type of the vertex key
      * @tparam IsDirected true if the graph is directed
+     * @param n_threads the maximum number of threads used for the adjacency matrices (0 for the hardware concurrency)
      * @details The transitive closure of a graph is a graph which will add an edge from vertex i to vertex j if they are indirectly linked
      * So that if there is a path from i to j, and there is an edge from j to k, there will be an edge from i to k
-     * @remark The algorithm is derived from the Floyd-Warshall algorithm. 
-     * @remark Its complexity is O(n^3) where n is the number of vertices for a densely connected graph 
-     * but tends to O(n^2) as the graph becomes sparser.
+     * @see transitive_closure(G&, unsigned)
      */
     template<typename Impl, VertexKey Vertex>
     requires GraphImpl<Impl, typename Impl::weight_lt>
-    void transitive_closure(Graph<Impl, Vertex, true, typename Impl::weight_lt>& graph) {     
-        transitive_closure(graph.get_impl());
+    void transitive_closure(Graph<Impl, Vertex, true, typename Impl::weight_lt>& graph, unsigned n_threads = 0) {
+        transitive_closure(graph.get_impl(), n_threads);
     }
 
     template<typename Impl, VertexKey Vertex>
     requires GraphImpl<Impl, typename Impl::weight_lt>
-    void transitive_closure(Graph<Impl, Vertex, false, typename Impl::weight_lt>& graph) {     
+    void transitive_closure(Graph<Impl, Vertex, false, typename Impl::weight_lt>& graph, unsigned n_threads = 0) {
         static_assert(false, "Transitive closure works only on directed graphs");
     }
 } // namespace grafology
@@ -0,0 +1,312 @@
+#pragma once
+#include "graph_impl.h"
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace grafology {
+    /**
+     * @brief A dense graph implementation for unweighted graphs which use a bit-packed adjacency matrix
+     * @details Each row of the adjacency matrix is stored as an array of 64 bits words. A bit is set
+     * if there is an edge from the row vertex to the column vertex. So this uses 32 times less memory
+     * than a DenseGraphImpl<int>.
+     * - all the edges have a weight of 1. Setting a non zero weight adds the edge, setting a zero
+     * weight removes it.
+     * - degrees are computed with popcount and neighbors are found with count-trailing-zeros.
+     * - for directed graphs, the transposed matrix can be maintained (see the constructor parameter
+     * with_in_edges) so that the in-neighbors queries are as fast as the neighbors ones.
+     * @warning Once built, the graph capacity cannot be changed.
+     */
+    template<Number weight_t>
+    class BitDenseGraphImpl {
+    public:
+        using edge_lt = edge_t<weight_t>;
+        using weight_lt = weight_t;
+        using word_t = std::uint64_t;
+        static constexpr unsigned WORD_BITS = 64;
+
+        BitDenseGraphImpl(unsigned n_max_vertices, unsigned n_vertices, bool is_directed, bool with_in_edges = false) :
+          _is_directed(is_directed),
+          _has_in_edges(is_directed && with_in_edges),
+          _n_max_vertices(n_max_vertices),
+          _n_vertices(n_vertices),
+          _n_words((n_max_vertices + WORD_BITS - 1) / WORD_BITS),
+          _adjacency_matrix(static_cast<std::size_t>(_n_max_vertices) * _n_words, 0) {
+            assert(n_vertices <= n_max_vertices);
+            if (_has_in_edges) {
+                _in_adjacency_matrix.resize(_adjacency_matrix.size(), 0);
+            }
+        }
+
+        BitDenseGraphImpl(const BitDenseGraphImpl&) = default;
+        BitDenseGraphImpl(BitDenseGraphImpl&&) = default;
+        BitDenseGraphImpl& operator=(const BitDenseGraphImpl&) = default;
+        BitDenseGraphImpl& operator=(BitDenseGraphImpl&&) = default;
+        bool operator==(const BitDenseGraphImpl& other) const = default;
+        bool operator!=(const BitDenseGraphImpl& other) const = default;
+
+        unsigned size() const { return _n_vertices; }
+
+        unsigned capacity() const { return _n_max_vertices; }
+
+        bool is_directed() const { return _is_directed; }
+
+        /** @brief true if the transposed matrix is maintained */
+        bool has_in_edges() const { return _has_in_edges; }
+
+        weight_t operator()(vertex_t i, vertex_t j) const {
+            assert(i < _n_vertices && j < _n_vertices);
+            return has_edge(i, j) ? 1 : 0;
+        }
+
+        bool has_edge(vertex_t i, vertex_t j) const {
+            assert(i < _n_vertices && j < _n_vertices);
+            return test(_adjacency_matrix, i, j);
+        }
+
+        edge_lt get_edge(vertex_t i, vertex_t j) const {
+            assert(i < _n_vertices && j < _n_vertices);
+            return {.start = i, .end = j, .weight = weight(i, j)};
+        }
+
+        weight_t weight(vertex_t i, vertex_t j) const {
+            assert(i < _n_vertices && j < _n_vertices);
+            return has_edge(i, j) ? 1 : 0;
+        }
+
+        vertex_t add_vertex() {
+            assert(_n_vertices < _n_max_vertices);
+            // edges are never set outside of [0, _n_vertices), so the new row and column are empty
+            ++_n_vertices;
+            return _n_vertices - 1;
+        }
+
+        /**
+         * @brief Batch add vertices
+         * @remark This returns an iterator because when the removal of vertices will be implemented#
+         * it will return first the "free" vertex slots, so indices won't be contiguous anymore.
+         * @remark In order to add the vertices, the generator must be iterated
+        */
+        generator<vertex_t> add_vertices(unsigned n) {
+            assert(_n_vertices + n <= _n_max_vertices);
+            for (unsigned i = 0; i < n; ++i) {
+                co_yield add_vertex();
+            }
+        }
+
+        /** @brief Add an edge if the weight is not zero, remove it otherwise */
+        void set_edge(vertex_t i, vertex_t j, weight_t weight) {
+            assert(i < _n_vertices && j < _n_vertices);
+            assign(_adjacency_matrix, i, j, weight != 0);
+            if (!_is_directed) {
+                assign(_adjacency_matrix, j, i, weight != 0);
+            } else if (_has_in_edges) {
+                assign(_in_adjacency_matrix, j, i, weight != 0);
+            }
+        }
+
+        void set_edge(const edge_lt& edge) {
+            assert(edge.start < _n_vertices && edge.end < _n_vertices);
+            set_edge(edge.start, edge.end, edge.weight);
+        }
+
+        template<input_iterator_value<edge_lt> I, std::sentinel_for<I> S>
+        void set_edges(I first, S last) {
+            for (auto it = first; it != last; ++it) {
+                edge_lt edge = *it;
+                set_edge(edge);
+            }
+        }
+
+        template<input_range_value<edge_lt> R>
+        void set_edges(R &&r) {
+            set_edges(std::begin(r), std::end(r));
+        }
+
+        void set_edges(generator<edge_lt>& g) {
+            for (const auto& edge : g) {
+                set_edge(edge);
+            }
+        }
+
+        std::size_t degree(vertex_t vertex) const {
+            assert(vertex < _n_vertices);
+            std::size_t degree = 0;
+            for (auto word : get_row(vertex)) {
+                degree += std::popcount(word);
+            }
+            return degree;
+        }
+
+        std::size_t in_degree(vertex_t vertex) const {
+            assert(vertex < _n_vertices);
+            if (!_is_directed) {
+                return degree(vertex);
+            }
+            if (_has_in_edges) {
+                std::size_t in_degree = 0;
+                for (auto word : get_row(_in_adjacency_matrix, vertex)) {
+                    in_degree += std::popcount(word);
+                }
+                return in_degree;
+            }
+            std::size_t in_degree = 0;
+            for (vertex_t i = 0; i < _n_vertices; ++i) {
+                if (test(_adjacency_matrix, i, vertex)) {
+                    ++in_degree;
+                }
+            }
+            return in_degree;
+        }
+
+        /** @brief The words of the row of a vertex. The bit j is set if there is an edge to j */
+        std::span<const word_t> get_row(vertex_t vertex) const {
+            assert(vertex < _n_vertices);
+            return get_row(_adjacency_matrix, vertex);
+        }
+
+        generator<vertex_t> get_raw_neighbors(vertex_t vertex) const {
+            assert(vertex < _n_vertices);
+            auto row = get_row(vertex);
+            for (std::size_t w = 0; w < row.size(); ++w) {
+                for (auto word = row[w]; word != 0; word &= word - 1) {
+                    vertex_t j = w * WORD_BITS + std::countr_zero(word);
+                    if (j != vertex) {
+                        co_yield j;
+                    }
+                }
+            }
+        }
+
+        generator<edge_lt> get_neighbors(vertex_t vertex) const {
+            for (auto j : get_raw_neighbors(vertex)) {
+                co_yield {.start = vertex, .end = j, .weight = 1};
+            }
+        }
+
+        template<typename F>
+        void for_each_neighbor(vertex_t vertex, F&& f) const {
+            assert(vertex < _n_vertices);
+            for_each_bit(_adjacency_matrix, vertex, [&](vertex_t j) {
+                f(edge_lt{.start = vertex, .end = j, .weight = 1});
+            });
+        }
+
+        template<typename F>
+        void for_each_in_neighbor(vertex_t vertex, F&& f) const {
+            assert(vertex < _n_vertices);
+            if (!_is_directed || _has_in_edges) {
+                for_each_bit(_is_directed ? _in_adjacency_matrix : _adjacency_matrix, vertex, [&](vertex_t i) {
+                    f(edge_lt{.start = i, .end = vertex, .weight = 1});
+                });
+                return;
+            }
+            for (vertex_t i = 0; i < _n_vertices; ++i) {
+                if (i != vertex && test(_adjacency_matrix, i, vertex)) {
+                    f(edge_lt{.start = i, .end = vertex, .weight = 1});
+                }
+            }
+        }
+
+        generator<vertex_t> get_raw_in_neighbors(vertex_t vertex) const {
+            assert(vertex < _n_vertices);
+            if (!_is_directed || _has_in_edges) {
+                auto row = get_row(_is_directed ? _in_adjacency_matrix : _adjacency_matrix, vertex);
+                for (std::size_t w = 0; w < row.size(); ++w) {
+                    for (auto word = row[w]; word != 0; word &= word - 1) {
+                        vertex_t i = w * WORD_BITS + std::countr_zero(word);
+                        if (i != vertex) {
+                            co_yield i;
+                        }
+                    }
+                }
+            } else {
+                for (vertex_t i = 0; i < _n_vertices; ++i) {
+                    if (i != vertex && test(_adjacency_matrix, i, vertex)) {
+                        co_yield i;
+                    }
+                }
+            }
+        }
+
+        generator<edge_lt> get_in_neighbors(vertex_t vertex) const {
+            for (auto i : get_raw_in_neighbors(vertex)) {
+                co_yield {.start = i, .end = vertex, .weight = 1};
+            }
+        }
+
+        BitDenseGraphImpl invert() const {
+            if (!_is_directed) {
+                return *this;
+            }
+            BitDenseGraphImpl inverted(*this);
+            if (_has_in_edges) {
+                std::swap(inverted._adjacency_matrix, inverted._in_adjacency_matrix);
+            } else {
+                std::ranges::fill(inverted._adjacency_matrix, 0);
+                for (vertex_t i = 0; i < _n_vertices; ++i) {
+                    for_each_bit(_adjacency_matrix, i, [&](vertex_t j) {
+                        assign(inverted._adjacency_matrix, j, i, true);
+                    }, false);
+                }
+            }
+            return inverted;
+        }
+
+        generator<edge_lt> get_all_edges() const {
+            for (vertex_t i = 0; i < _n_vertices; ++i) {
+                auto row = get_row(i);
+                // for undirected graphs, only the upper triangle is used for avoiding duplicates
+                for (std::size_t w = _is_directed ? 0 : i / WORD_BITS; w < row.size(); ++w) {
+                    for (auto word = row[w]; word != 0; word &= word - 1) {
+                        vertex_t j = w * WORD_BITS + std::countr_zero(word);
+                        if (_is_directed || i <= j) {
+                            co_yield {.start = i, .end = j, .weight = 1};
+                        }
+                    }
+                }
+            }
+        }
+
+    private:
+        std::span<const word_t> get_row(const std::vector<word_t>& matrix, vertex_t vertex) const {
+            // only the words covering the current vertices are returned
+            return {matrix.data() + static_cast<std::size_t>(vertex) * _n_words, (_n_vertices + WORD_BITS - 1) / WORD_BITS};
+        }
+
+        bool test(const std::vector<word_t>& matrix, vertex_t i, vertex_t j) const {
+            return (matrix[static_cast<std::size_t>(i) * _n_words + j / WORD_BITS] >> (j % WORD_BITS)) & 1;
+        }
+
+        void assign(std::vector<word_t>& matrix, vertex_t i, vertex_t j, bool value) const {
+            auto& word = matrix[static_cast<std::size_t>(i) * _n_words + j / WORD_BITS];
+            const word_t mask = word_t{1} << (j % WORD_BITS);
+            word = value ? (word | mask) : (word & ~mask);
+        }
+
+        /** @brief call f(j) for each bit j set in the row of a vertex */
+        template<typename F>
+        void for_each_bit(const std::vector<word_t>& matrix, vertex_t vertex, F&& f, bool skip_self = true) const {
+            auto row = get_row(matrix, vertex);
+            for (std::size_t w = 0; w < row.size(); ++w) {
+                for (auto word = row[w]; word != 0; word &= word - 1) {
+                    vertex_t j = w * WORD_BITS + std::countr_zero(word);
+                    if (!skip_self || j != vertex) {
+                        f(j);
+                    }
+                }
+            }
+        }
+
+        bool _is_directed;
+        bool _has_in_edges;
+        unsigned _n_max_vertices;
+        unsigned _n_vertices;
+        std::size_t _n_words;
+        std::vector<word_t> _adjacency_matrix;
+        // the transposed matrix (only for directed graphs)
+        std::vector<word_t> _in_adjacency_matrix;
+    };
+
+} // namespace grafology
@@ -0,0 +1,438 @@
+#pragma once
+#include "graph_impl.h"
+#include <vector>
+#include <algorithm>
+
+namespace grafology {
+    /**
+     * @brief A read-optimised graph implementation which uses compressed sparse rows (CSR)
+     * @details The edges are stored in 3 contiguous arrays:
+     * - the offsets: the edges starting at vertex i are stored in [offsets[i], offsets[i+1])
+     * - the columns: the end vertex of each edge. They are sorted inside each row.
+     * - the weights: the weight of each edge
+     *
+     * For directed graphs, a reverse CSR (the CSR of the inverted graph) can be maintained so that
+     * the in-neighbors queries cost O(in-degree) instead of O(V+E). For undirected graphs, it is
+     * never needed as the in-neighbors are the neighbors.
+     * @remark Modifying the weight of an existing edge is O(log(degree)) but adding or removing an
+     * edge with set_edge() is O(E) as the arrays have to be shifted. set_edges() should be used
+     * when loading a graph: it rebuilds the arrays in a single pass.
+     * @warning Once built, the graph capacity cannot be changed.
+     */
+    template<Number weight_t>
+    class CSRGraphImpl {
+    public:
+        using edge_lt = edge_t<weight_t>;
+        using weight_lt = weight_t;
+
+        CSRGraphImpl(unsigned n_max_vertices, unsigned n_vertices, bool is_directed, bool with_in_edges = true) :
+          _is_directed(is_directed),
+          _has_in_edges(is_directed && with_in_edges),
+          _n_max_vertices(n_max_vertices),
+          _n_vertices(n_vertices),
+          _offsets(n_max_vertices + 1, 0) {
+            assert(n_vertices <= n_max_vertices);
+            if (_has_in_edges) {
+                _in_offsets.assign(n_max_vertices + 1, 0);
+            }
+        }
+        CSRGraphImpl(const CSRGraphImpl&) = default;
+        CSRGraphImpl(CSRGraphImpl&&) = default;
+        CSRGraphImpl& operator=(const CSRGraphImpl&) = default;
+        CSRGraphImpl& operator=(CSRGraphImpl&&) = default;
+        bool operator==(const CSRGraphImpl& other) const = default;
+        bool operator!=(const CSRGraphImpl& other) const = default;
+
+        unsigned size() const { return _n_vertices; }
+
+        unsigned capacity() const { return _n_max_vertices; }
+
+        bool is_directed() const { return _is_directed; }
+
+        /** @brief true if the reverse CSR is maintained */
+        bool has_in_edges() const { return _has_in_edges; }
+
+        /** @brief the number of stored edges (undirected edges are stored twice) */
+        std::size_t n_edges() const { return _columns.size(); }
+
+        weight_t operator()(vertex_t i, vertex_t j) const {
+            assert(i < _n_vertices && j < _n_vertices);
+            return weight(i, j);
+        }
+
+        bool has_edge(vertex_t i, vertex_t j) const {
+            assert(i < _n_vertices && j < _n_vertices);
+            return find(_offsets, _columns, i, j) != NPOS;
+        }
+
+        edge_lt get_edge(vertex_t i, vertex_t j) const {
+            assert(i < _n_vertices && j < _n_vertices);
+            return {.start = i, .end = j, .weight = weight(i, j)};
+        }
+
+        weight_t weight(vertex_t i, vertex_t j) const {
+            assert(i < _n_vertices && j < _n_vertices);
+            auto pos = find(_offsets, _columns, i, j);
+            return pos == NPOS ? 0 : _weights[pos];
+        }
+
+        vertex_t add_vertex() {
+            assert(_n_vertices < _n_max_vertices);
+            // the rows of the unused vertices are already allocated and empty
+            ++_n_vertices;
+            return _n_vertices - 1;
+        }
+
+        /**
+         * @brief Batch add vertices
+         * @remark This returns an iterator because when the removal of vertices will be implemented#
+         * it will return first the "free" vertex slots, so indices won't be contiguous anymore.
+        */
+        generator<vertex_t> add_vertices(unsigned n) {
+            assert(_n_vertices + n <= _n_max_vertices);
+            for (unsigned i = 0; i < n; i++) {
+                co_yield add_vertex();
+            }
+        }
+
+        /**
+         * @brief Set the weight of an edge. A weight of 0 removes the edge.
+         * @remark this is O(E) if the edge has to be added or removed
+         */
+        void set_edge(vertex_t start, vertex_t end, weight_t weight) {
+            assert(start < _n_vertices && end < _n_vertices);
+            update(_offsets, _columns, _weights, start, end, weight);
+            if (!_is_directed) {
+                if (start != end) {
+                    update(_offsets, _columns, _weights, end, start, weight);
+                }
+            } else if (_has_in_edges) {
+                update(_in_offsets, _in_columns, _in_weights, end, start, weight);
+            }
+        }
+
+        void set_edge(const edge_lt& edge) {
+            assert(edge.start < _n_vertices && edge.end < _n_vertices);
+            set_edge(edge.start, edge.end, edge.weight);
+        }
+
+        /**
+         * @brief Batch set edges
+         * @details The arrays are rebuilt in a single pass: this is O(E + k.log(k)) where k is
+         * the number of new edges. When an edge is given several times, the last weight wins.
+         */
+        template<input_iterator_value<edge_lt> I, std::sentinel_for<I> S>
+        void set_edges(I first, S last) {
+            std::vector<edge_lt> edges;
+            for (auto it = first; it != last; ++it) {
+                edge_lt edge = *it;
+                assert(edge.start < _n_vertices && edge.end < _n_vertices);
+                edges.push_back(edge);
+            }
+            merge_edges(std::move(edges));
+        }
+
+        template<input_range_value<edge_lt> R>
+        void set_edges(R &&r) {
+            set_edges(std::begin(r), std::end(r));
+        }
+
+        void set_edges(generator<edge_lt>& g) {
+            set_edges(g.begin(), g.end());
+        }
+
+        std::size_t degree(vertex_t vertex) const {
+            assert(vertex < _n_vertices);
+            return _offsets[vertex + 1] - _offsets[vertex];
+        }
+
+        std::size_t in_degree(vertex_t vertex) const {
+            assert(vertex < _n_vertices);
+            if (!is_directed()) {
+                return degree(vertex);
+            }
+            if (_has_in_edges) {
+                return _in_offsets[vertex + 1] - _in_offsets[vertex];
+            }
+            return std::ranges::count(_columns, vertex);
+        }
+
+        generator<vertex_t> get_raw_neighbors(vertex_t vertex) const {
+            assert(vertex < _n_vertices);
+            for (auto pos = _offsets[vertex]; pos < _offsets[vertex + 1]; ++pos) {
+                if (_columns[pos] != vertex) {
+                    co_yield _columns[pos];
+                }
+            }
+        }
+
+        generator<edge_lt> get_neighbors(vertex_t vertex) const {
+            assert(vertex < _n_vertices);
+            for (auto pos = _offsets[vertex]; pos < _offsets[vertex + 1]; ++pos) {
+                if (_columns[pos] != vertex) {
+                    co_yield {.start = vertex, .end = _columns[pos], .weight = _weights[pos]};
+                }
+            }
+        }
+
+        template<typename F>
+        void for_each_neighbor(vertex_t vertex, F&& f) const {
+            assert(vertex < _n_vertices);
+            for (auto pos = _offsets[vertex]; pos < _offsets[vertex + 1]; ++pos) {
+                if (_columns[pos] != vertex) {
+                    f(edge_lt{.start = vertex, .end = _columns[pos], .weight = _weights[pos]});
+                }
+            }
+        }
+
+        template<typename F>
+        void for_each_in_neighbor(vertex_t vertex, F&& f) const {
+            assert(vertex < _n_vertices);
+            if (!_is_directed || _has_in_edges) {
+                const auto& offsets = _is_directed ? _in_offsets : _offsets;
+                const auto& columns = _is_directed ? _in_columns : _columns;
+                const auto& weights = _is_directed ? _in_weights : _weights;
+                for (auto pos = offsets[vertex]; pos < offsets[vertex + 1]; ++pos) {
+                    if (columns[pos] != vertex) {
+                        f(edge_lt{.start = columns[pos], .end = vertex, .weight = weights[pos]});
+                    }
+                }
+            } else {
+                for (vertex_t i = 0; i < _n_vertices; ++i) {
+                    if (i == vertex) {
+                        continue;
+                    }
+                    auto pos = find(_offsets, _columns, i, vertex);
+                    if (pos != NPOS) {
+                        f(edge_lt{.start = i, .end = vertex, .weight = _weights[pos]});
+                    }
+                }
+            }
+        }
+
+        generator<vertex_t> get_raw_in_neighbors(vertex_t vertex) const {
+            assert(vertex < _n_vertices);
+            if (!_is_directed || _has_in_edges) {
+                const auto& offsets = _is_directed ? _in_offsets : _offsets;
+                const auto& columns = _is_directed ? _in_columns : _columns;
+                for (auto pos = offsets[vertex]; pos < offsets[vertex + 1]; ++pos) {
+                    if (columns[pos] != vertex) {
+                        co_yield columns[pos];
+                    }
+                }
+            } else {
+                for (vertex_t i = 0; i < _n_vertices; ++i) {
+                    if (i != vertex && find(_offsets, _columns, i, vertex) != NPOS) {
+                        co_yield i;
+                    }
+                }
+            }
+        }
+
+        generator<edge_lt> get_in_neighbors(vertex_t vertex) const {
+            assert(vertex < _n_vertices);
+            if (!_is_directed || _has_in_edges) {
+                const auto& offsets = _is_directed ? _in_offsets : _offsets;
+                const auto& columns = _is_directed ? _in_columns : _columns;
+                const auto& weights = _is_directed ? _in_weights : _weights;
+                for (auto pos = offsets[vertex]; pos < offsets[vertex + 1]; ++pos) {
+                    if (columns[pos] != vertex) {
+                        co_yield {.start = columns[pos], .end = vertex, .weight = weights[pos]};
+                    }
+                }
+            } else {
+                for (vertex_t i = 0; i < _n_vertices; ++i) {
+                    if (i == vertex) {
+                        continue;
+                    }
+                    auto pos = find(_offsets, _columns, i, vertex);
+                    if (pos != NPOS) {
+                        co_yield {.start = i, .end = vertex, .weight = _weights[pos]};
+                    }
+                }
+            }
+        }
+
+        CSRGraphImpl<weight_t> invert() const {
+            if (!_is_directed) {
+                return *this;
+            }
+            CSRGraphImpl inverted(*this);
+            if (_has_in_edges) {
+                std::swap(inverted._offsets, inverted._in_offsets);
+                std::swap(inverted._columns, inverted._in_columns);
+                std::swap(inverted._weights, inverted._in_weights);
+            } else {
+                transpose(_offsets, _columns, _weights, inverted._offsets, inverted._columns, inverted._weights);
+            }
+            return inverted;
+        }
+
+        generator<edge_lt> get_all_edges() const {
+            for (vertex_t i = 0; i < _n_vertices; i++) {
+                for (auto pos = _offsets[i]; pos < _offsets[i + 1]; ++pos) {
+                    // for undirected graphs, we need to avoid duplicates
+                    if (_is_directed || i <= _columns[pos]) {
+                        co_yield {.start = i, .end = _columns[pos], .weight = _weights[pos]};
+                    }
+                }
+            }
+        }
+
+    private:
+        using offset_t = std::size_t;
+        static constexpr offset_t NPOS = std::numeric_limits<offset_t>::max();
+
+        /** @brief returns the position of the edge (row, column) or NPOS */
+        static offset_t find(
+            const std::vector<offset_t>& offsets,
+            const std::vector<vertex_t>& columns,
+            vertex_t row,
+            vertex_t column
+        ) {
+            auto first = columns.begin() + offsets[row];
+            auto last = columns.begin() + offsets[row + 1];
+            auto it = std::lower_bound(first, last, column);
+            if (it != last && *it == column) {
+                return it - columns.begin();
+            }
+            return NPOS;
+        }
+
+        /** @brief set the weight of the edge (row, column), inserting or removing it if needed */
+        static void update(
+            std::vector<offset_t>& offsets,
+            std::vector<vertex_t>& columns,
+            std::vector<weight_t>& weights,
+            vertex_t row,
+            vertex_t column,
+            weight_t weight
+        ) {
+            auto first = columns.begin() + offsets[row];
+            auto last = columns.begin() + offsets[row + 1];
+            auto it = std::lower_bound(first, last, column);
+            auto pos = it - columns.begin();
+            if (it != last && *it == column) {
+                if (weight != 0) {
+                    weights[pos] = weight;
+                    return;
+                }
+                columns.erase(it);
+                weights.erase(weights.begin() + pos);
+                for (auto i = row + 1; i < offsets.size(); ++i) {
+                    --offsets[i];
+                }
+            } else if (weight != 0) {
+                columns.insert(it, column);
+                weights.insert(weights.begin() + pos, weight);
+                for (auto i = row + 1; i < offsets.size(); ++i) {
+                    ++offsets[i];
+                }
+            }
+        }
+
+        /** @brief build the CSR of the inverted graph using a counting sort */
+        static void transpose(
+            const std::vector<offset_t>& offsets,
+            const std::vector<vertex_t>& columns,
+            const std::vector<weight_t>& weights,
+            std::vector<offset_t>& t_offsets,
+            std::vector<vertex_t>& t_columns,
+            std::vector<weight_t>& t_weights
+        ) {
+            t_offsets.assign(offsets.size(), 0);
+            for (auto column : columns) {
+                ++t_offsets[column + 1];
+            }
+            for (std::size_t i = 1; i < t_offsets.size(); ++i) {
+                t_offsets[i] += t_offsets[i - 1];
+            }
+            t_columns.resize(columns.size());
+            t_weights.resize(weights.size());
+            std::vector<offset_t> cursor(t_offsets.begin(), t_offsets.end() - 1);
+            // rows are scanned in order, so the transposed rows are sorted
+            for (vertex_t row = 0; row + 1 < offsets.size(); ++row) {
+                for (auto pos = offsets[row]; pos < offsets[row + 1]; ++pos) {
+                    auto t_pos = cursor[columns[pos]]++;
+                    t_columns[t_pos] = row;
+                    t_weights[t_pos] = weights[pos];
+                }
+            }
+        }
+
+        /** @brief merge a batch of edges with the existing ones and rebuild the arrays */
+        void merge_edges(std::vector<edge_lt>&& edges) {
+            if (!_is_directed) {
+                // each reversed edge comes right after its edge, so the last weight given for an edge
+                // wins in both directions
+                std::vector<edge_lt> both_directions;
+                both_directions.reserve(2 * edges.size());
+                for (const auto& edge : edges) {
+                    both_directions.push_back(edge);
+                    if (edge.start != edge.end) {
+                        both_directions.push_back({.start = edge.end, .end = edge.start, .weight = edge.weight});
+                    }
+                }
+                edges = std::move(both_directions);
+            }
+            // stable so that the last weight given for an edge wins
+            std::ranges::stable_sort(edges);
+
+            std::vector<offset_t> offsets(_offsets.size(), 0);
+            std::vector<vertex_t> columns;
+            std::vector<weight_t> weights;
+            columns.reserve(_columns.size() + edges.size());
+            weights.reserve(_weights.size() + edges.size());
+
+            auto it = edges.begin();
+            for (vertex_t row = 0; row < _n_max_vertices; ++row) {
+                auto pos = _offsets[row];
+                const auto last = _offsets[row + 1];
+                while (pos < last || (it != edges.end() && it->start == row)) {
+                    vertex_t column;
+                    weight_t weight;
+                    if (it == edges.end() || it->start != row || (pos < last && _columns[pos] < it->end)) {
+                        column = _columns[pos];
+                        weight = _weights[pos];
+                        ++pos;
+                    } else {
+                        column = it->end;
+                        // skip the duplicates: the last one wins
+                        while (std::next(it) != edges.end() && *std::next(it) == *it) {
+                            ++it;
+                        }
+                        weight = it->weight;
+                        ++it;
+                        if (pos < last && _columns[pos] == column) {
+                            ++pos;
+                        }
+                    }
+                    if (weight != 0) {
+                        columns.push_back(column);
+                        weights.push_back(weight);
+                    }
+                }
+                offsets[row + 1] = columns.size();
+            }
+            _offsets = std::move(offsets);
+            _columns = std::move(columns);
+            _weights = std::move(weights);
+            if (_has_in_edges) {
+                transpose(_offsets, _columns, _weights, _in_offsets, _in_columns, _in_weights);
+            }
+        }
+
+        bool _is_directed;
+        bool _has_in_edges;
+        unsigned _n_max_vertices;
+        unsigned _n_vertices;
+        std::vector<offset_t> _offsets;
+        std::vector<vertex_t> _columns;
+        std::vector<weight_t> _weights;
+        // the reverse CSR (only for directed graphs)
+        std::vector<offset_t> _in_offsets;
+        std::vector<vertex_t> _in_columns;
+        std::vector<weight_t> _in_weights;
+    };
+
+} // namespace grafology
@@ -167,6 +167,29 @@ namespace grafology {
             }
         }
 
+        template<typename F>
+        void for_each_neighbor(vertex_t vertex, F&& f) const {
+            assert(vertex < _n_vertices);
+            auto rowStart = _adjacency_matrix.data() + vertex*_n_max_vertices;
+            for (vertex_t i = 0; i < _n_vertices; ++i) {
+                auto weight = *(rowStart+i);
+                if (weight != 0 && i != vertex) {
+                    f(edge_lt{.start = vertex, .end = i, .weight = weight});
+                }
+            }
+        }
+
+        template<typename F>
+        void for_each_in_neighbor(vertex_t vertex, F&& f) const {
+            assert(vertex < _n_vertices);
+            for (vertex_t i = 0; i < _n_vertices; ++i) {
+                auto weight = _adjacency_matrix[i*_n_max_vertices+vertex];
+                if (weight != 0 && i != vertex) {
+                    f(edge_lt{.start = i, .end = vertex, .weight = weight});
+                }
+            }
+        }
+
         generator<vertex_t> get_raw_in_neighbors(vertex_t vertex) const {
             assert(vertex < _n_vertices);
             for (vertex_t i = 0; i < _n_vertices; ++i) {
@@ -1,52 +1,236 @@
+#pragma once
 #include "graph_impl.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <ranges>
+#include <thread>
 #include <vector>
+#include <numeric>
 #include <cassert>
 
 namespace grafology {
     /**
      * @brief A disjoint set data structure
      * @details This data structure is used to keep track of the connected components of a graph.
-     * @remarks The implementation uses the path compression optimization so find is not const.
+     * The sets are merged by size (the root of the smaller set is attached to the root of the larger one),
+     * so the trees have a logarithmic height, and find halves the paths it follows. The amortized cost
+     * of find and merge is almost constant (inverse Ackermann).
+     * @remarks find is iterative, so long chains can't overflow the stack. It changes the parents, so it is not const.
      */
     class DisjointSet {
-        static constexpr vertex_t NPOS {std::numeric_limits<vertex_t>::max()};
         public:
-            DisjointSet(size_t size) 
-            : _parent(size, NPOS) {}
+            DisjointSet(size_t size)
+            : _parent(size)
+            , _sizes(size, 1)
+            , _count(size) {
+                std::iota(_parent.begin(), _parent.end(), vertex_t{0});
+            }
 
+            /** @brief the root of the set of v */
             vertex_t find(vertex_t v) {
                 assert(v < _parent.size());
-                if (_parent[v] == NPOS)
-                {
-                    return v;
+                // with path halving: each vertex of the path is attached to its grandparent
+                while (_parent[v] != v) {
+                    _parent[v] = _parent[_parent[v]];
+                    v = _parent[v];
                 }
-
-                // with path compression optimization
-                auto r = find(_parent[v]);
-                _parent[v] = r;
-                return r;
+                return v;
             }
 
+            /** @brief merge the sets of v1 and v2, return false if they were already in the same set */
             bool merge(vertex_t v1, vertex_t v2) {
                 assert(v1 < _parent.size() && v2 < _parent.size());
                 vertex_t root1 = find(v1);
                 vertex_t root2 = find(v2);
-                if (root1 != root2) {
-                    _parent[root1] = root2;
-                    return true;
+                if (root1 == root2) {
+                    return false;
+                }
+                if (_sizes[root1] > _sizes[root2]) {
+                    std::swap(root1, root2);
+                }
+                _parent[root1] = root2;
+                _sizes[root2] += _sizes[root1];
+                --_count;
+                return true;
+            }
+
+            /** @brief merge the ends of each edge, return the number of merges which joined two sets */
+            template <std::ranges::input_range Edges>
+            std::size_t merge_all(Edges&& edges) {
+                std::size_t n_merges = 0;
+                for (const auto& edge : edges) {
+                    if (merge(edge.start, edge.end)) {
+                        ++n_merges;
+                    }
                 }
-                return false;
+                return n_merges;
+            }
+
+            /** @brief the number of disjoint sets */
+            std::size_t count() const { return _count; }
+
+            /** @brief the number of elements in the set of v */
+            std::size_t size_of(vertex_t v) {
+                return _sizes[find(v)];
             }
 
             generator<vertex_t> roots() const {
                 for (vertex_t i = 0; i < _parent.size(); ++i) {
-                    if (_parent[i] == NPOS) {
+                    if (_parent[i] == i) {
                         co_yield i;
                     }
                 }
             }
-            
+
         private:
             std::vector<vertex_t> _parent;
+            // the size of each set, valid for the roots only
+            std::vector<std::size_t> _sizes;
+            std::size_t _count;
+    };
+    /**
+     * @brief A disjoint set data structure which can be shared between threads
+     * @details find and merge can be called concurrently from any number of threads, without lock:
+     * - the parents are atomic and a root is linked to another root with a compare-and-swap, which fails
+     * (and the merge is retried from the new roots) if another thread linked it first
+     * - the roots are linked by a fixed random order of the vertices (a bijective hash of their index),
+     * as in the randomized linking of Jayanti and Tarjan, so the trees have a logarithmic expected height
+     * without any rank or size to keep up to date
+     * - find halves the paths with compare-and-swaps which are never retried: a failed one only means that
+     * another thread already shortened the path, so find never waits for the other threads
+     * @remarks roots() must not be called while other threads merge sets
+     */
+    class ConcurrentDisjointSet {
+        public:
+            ConcurrentDisjointSet(size_t size)
+            : _size(size)
+            , _parent(std::make_unique<std::atomic<vertex_t>[]>(size))
+            , _count(size) {
+                for (vertex_t v = 0; v < size; ++v) {
+                    _parent[v].store(v, std::memory_order_relaxed);
+                }
+            }
+
+            /** @brief the current root of the set of v */
+            vertex_t find(vertex_t v) {
+                assert(v < _size);
+                while (true) {
+                    auto parent = _parent[v].load(std::memory_order_acquire);
+                    if (parent == v) {
+                        return v;
+                    }
+                    auto grandparent = _parent[parent].load(std::memory_order_acquire);
+                    if (parent != grandparent) {
+                        // path halving, left to the other threads if the parent has changed meanwhile
+                        _parent[v].compare_exchange_weak(parent, grandparent, std::memory_order_acq_rel, std::memory_order_relaxed);
+                    }
+                    v = grandparent;
+                }
+            }
+
+            /** @brief merge the sets of v1 and v2, return false if they were already in the same set */
+            bool merge(vertex_t v1, vertex_t v2) {
+                assert(v1 < _size && v2 < _size);
+                while (true) {
+                    v1 = find(v1);
+                    v2 = find(v2);
+                    if (v1 == v2) {
+                        return false;
+                    }
+                    if (priority(v1) > priority(v2)) {
+                        std::swap(v1, v2);
+                    }
+                    // v1 is linked only if it is still a root
+                    auto expected = v1;
+                    if (_parent[v1].compare_exchange_strong(expected, v2, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                        _count.fetch_sub(1, std::memory_order_relaxed);
+                        return true;
+                    }
+                }
+            }
+
+            /** @brief return true if v1 and v2 are in the same set (even if other threads are merging sets) */
+            bool same_set(vertex_t v1, vertex_t v2) {
+                assert(v1 < _size && v2 < _size);
+                while (true) {
+                    v1 = find(v1);
+                    v2 = find(v2);
+                    if (v1 == v2) {
+                        return true;
+                    }
+                    // v1 may have been linked to v2 after it has been found
+                    if (_parent[v1].load(std::memory_order_acquire) == v1) {
+                        return false;
+                    }
+                }
+            }
+
+            /**
+             * @brief merge the ends of each edge, with several threads which share the edges
+             * @param n_threads the number of threads (0 for the hardware concurrency)
+             * @return the number of merges which joined two sets
+             */
+            template <std::ranges::random_access_range Edges>
+            std::size_t merge_all(const Edges& edges, unsigned n_threads = 0) {
+                const std::size_t n_edges = std::ranges::size(edges);
+                if (n_threads == 0) {
+                    n_threads = std::max(1u, std::thread::hardware_concurrency());
+                }
+                // the edges are taken by chunks, which is enough to balance the work
+                constexpr std::size_t CHUNK_SIZE = 4096;
+                std::atomic<std::size_t> next_chunk = 0;
+                std::atomic<std::size_t> n_merges = 0;
+                auto worker = [&] {
+                    std::size_t n_local_merges = 0;
+                    for (auto begin = next_chunk.fetch_add(CHUNK_SIZE); begin < n_edges; begin = next_chunk.fetch_add(CHUNK_SIZE)) {
+                        auto end = std::min(begin + CHUNK_SIZE, n_edges);
+                        for (auto i = begin; i < end; ++i) {
+                            const auto& edge = std::ranges::begin(edges)[i];
+                            n_local_merges += merge(edge.start, edge.end);
+                        }
+                    }
+                    n_merges += n_local_merges;
+                };
+                {
+                    n_threads = std::max<std::size_t>(1, std::min<std::size_t>(n_threads, (n_edges + CHUNK_SIZE - 1) / CHUNK_SIZE));
+                    std::vector<std::jthread> threads;
+                    threads.reserve(n_threads - 1);
+                    for (unsigned t = 1; t < n_threads; ++t) {
+                        threads.emplace_back(worker);
+                    }
+                    worker();
+                }
+                return n_merges;
+            }
+
+            /** @brief the number of disjoint sets */
+            std::size_t count() const { return _count.load(std::memory_order_relaxed); }
+
+            generator<vertex_t> roots() const {
+                for (vertex_t i = 0; i < _size; ++i) {
+                    if (_parent[i].load(std::memory_order_relaxed) == i) {
+                        co_yield i;
+                    }
+                }
+            }
+
+        private:
+            /**
+             * @brief the rank of a vertex in a fixed random order
+             * @details the hash is a bijection (xor-shifts and products by an odd number, modulo 2^32), so the
+             * order is total and the priorities only increase along the paths to the roots: no cycle can be made
+             */
+            static std::uint32_t priority(vertex_t v) {
+                std::uint32_t x = v;
+                x = (x ^ (x >> 16)) * 0x45d9f3bu;
+                x = (x ^ (x >> 16)) * 0x45d9f3bu;
+                return x ^ (x >> 16);
+            }
+
+            std::size_t _size;
+            std::unique_ptr<std::atomic<vertex_t>[]> _parent;
+            std::atomic<std::size_t> _count;
     };
 } // namespace grafology
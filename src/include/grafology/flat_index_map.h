@@ -10,8 +10,6 @@ namespace grafology {
      */
     template<Number weight_t>
     class FlatIndexMap {
-        // TODO: batch initialization
-        // TODO: batch insertion (using Tim or Smooth Sort (as data are almost sorted) ?)
         public: 
             FlatIndexMap() = default;
             FlatIndexMap(const FlatIndexMap&) = default;
@@ -57,6 +55,45 @@ namespace grafology {
                 set(entry.vertex, entry.weight);
             }
 
+            /**
+             * @brief Batch insertion
+             * @details The new entries are sorted then merged with the existing ones in a single
+             * pass: this is O(n + k.log(k)) instead of O(n.k) for k calls to set().
+             * - if a vertex is given several times, the last weight wins
+             * - an entry with a zero weight removes the vertex
+             * @param first, last the new entries. They are reordered.
+             */
+            template<std::random_access_iterator I>
+            void merge(I first, I last) {
+                if (first == last) {
+                    return;
+                }
+                // stable so that the last weight given for a vertex can be found
+                std::stable_sort(first, last);
+                std::vector<MapEntry> merged;
+                merged.reserve(_flat_map.size() + (last - first));
+                auto it = _flat_map.cbegin();
+                while (first != last) {
+                    auto next = std::next(first);
+                    if (next != last && next->vertex == first->vertex) {
+                        first = next;
+                        continue;
+                    }
+                    while (it != _flat_map.cend() && it->vertex < first->vertex) {
+                        merged.push_back(*it++);
+                    }
+                    if (it != _flat_map.cend() && it->vertex == first->vertex) {
+                        ++it;
+                    }
+                    if (first->weight != 0) {
+                        merged.push_back(*first);
+                    }
+                    first = next;
+                }
+                merged.insert(merged.end(), it, _flat_map.cend());
+                _flat_map = std::move(merged);
+            }
+
             weight_t get(vertex_t vertex) const {
                 auto it = std::lower_bound(_flat_map.begin(), _flat_map.end(), MapEntry{vertex, 0});
                 if (it != _flat_map.end() && it->vertex == vertex) {
@@ -89,6 +126,10 @@ namespace grafology {
             auto size() const {
                 return _flat_map.size();
             }
+
+            auto capacity() const {
+                return _flat_map.capacity();
+            }
         private:
             std::vector<MapEntry> _flat_map;
     };
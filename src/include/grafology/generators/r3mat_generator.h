@@ -84,9 +84,12 @@ namespace grafology {
         gen.generate_degree_distribution(is_directed, n_vertices);
         auto edges = is_directed ? gen.generate_directed_edges() : gen.generate_undirected_edges();
         Impl g(n_max_vertices, n_vertices, is_directed);
+        // the edges are loaded in one batch as some implementations (CSR) are slow to update
+        std::vector<typename Impl::edge_lt> batch;
         for (auto e : edges) {
-            g.set_edge(e);
+            batch.push_back(e);
         }
+        g.set_edges(batch);
         return g;
     }
 
@@ -99,4 +102,9 @@ namespace grafology {
     inline DenseGraphImpl<weight_t> generate_r3mat_dense_graph(unsigned n_max_vertices, unsigned n_vertices, bool is_directed, unsigned seed = 0) {
         return generate_r3mat_graph<DenseGraphImpl<weight_t>>(n_max_vertices, n_vertices, is_directed, seed);
     }
+
+    template <typename weight_t>
+    inline CSRGraphImpl<weight_t> generate_r3mat_csr_graph(unsigned n_max_vertices, unsigned n_vertices, bool is_directed, unsigned seed = 0) {
+        return generate_r3mat_graph<CSRGraphImpl<weight_t>>(n_max_vertices, n_vertices, is_directed, seed);
+    }
 }  // namespace grafology
@@ -3,6 +3,8 @@
 #include "vertex.h"
 #include "sparse_graph_impl.h"
 #include "dense_graph_impl.h"
+#include "csr_graph_impl.h"
+#include "bit_dense_graph_impl.h"
 #include "bimap.h"
 
 namespace grafology {
@@ -255,4 +257,32 @@ namespace grafology {
     template<VertexKey Vertex, Number weight_t>
     using UndirectedDenseGraph = Graph<DenseGraphImpl<weight_t>, Vertex, false, weight_t>;
 
+    /**
+     * @brief A directed CSR graph
+     * @tparam Vertex The class used for identifying vertices
+     */
+    template<VertexKey Vertex, Number weight_t>
+    using DirectedCSRGraph = Graph<CSRGraphImpl<weight_t>, Vertex, true, weight_t>;
+
+    /**
+     * @brief An undirected CSR graph
+     * @tparam Vertex The class used for identifying vertices
+     */
+    template<VertexKey Vertex, Number weight_t>
+    using UndirectedCSRGraph = Graph<CSRGraphImpl<weight_t>, Vertex, false, weight_t>;
+
+    /**
+     * @brief A directed unweighted dense graph
+     * @tparam Vertex The class used for identifying vertices
+     */
+    template<VertexKey Vertex, Number weight_t>
+    using DirectedBitDenseGraph = Graph<BitDenseGraphImpl<weight_t>, Vertex, true, weight_t>;
+
+    /**
+     * @brief An undirected unweighted dense graph
+     * @tparam Vertex The class used for identifying vertices
+     */
+    template<VertexKey Vertex, Number weight_t>
+    using UndirectedBitDenseGraph = Graph<BitDenseGraphImpl<weight_t>, Vertex, false, weight_t>;
+
 } // namespace grafology
@@ -71,6 +71,52 @@ namespace grafology {
   } && requires(const G g1, const G g2) {
     { g1 == g2 } -> std::convertible_to<bool>;
   };
+
+  /**
+   * @brief The requirements for a graph implementation which can visit the neighbors of a vertex
+   * without allocating a generator
+   * @details The implementation must provide the member functions:
+   * - for_each_neighbor(vertex, f)
+   * - for_each_in_neighbor(vertex, f)
+   *
+   * which call f(const edge_t<weight_t>&) for each neighbor (self loops excluded) like
+   * get_neighbors() and get_in_neighbors() do.
+   */
+  template <typename G>
+  concept NeighborVisitor = requires(const G g, vertex_t i, void (*f)(const edge_t<typename G::weight_lt>&)) {
+    { g.for_each_neighbor(i, f) };
+    { g.for_each_in_neighbor(i, f) };
+  };
+
+  /**
+   * @brief Call f(const edge_t<weight_t>&) for each neighbor of a vertex (self loops excluded)
+   * @remark Algorithms should use this function instead of get_neighbors() as it doesn't allocate
+   * any coroutine frame when the implementation satisfies NeighborVisitor
+   */
+  template <typename G, typename F>
+  void for_each_neighbor(const G& graph, vertex_t vertex, F&& f) {
+    if constexpr (NeighborVisitor<G>) {
+      graph.for_each_neighbor(vertex, f);
+    } else {
+      for (const auto& edge : graph.get_neighbors(vertex)) {
+        f(edge);
+      }
+    }
+  }
+
+  /**
+   * @brief Call f(const edge_t<weight_t>&) for each in-neighbor of a vertex (self loops excluded)
+   */
+  template <typename G, typename F>
+  void for_each_in_neighbor(const G& graph, vertex_t vertex, F&& f) {
+    if constexpr (NeighborVisitor<G>) {
+      graph.for_each_in_neighbor(vertex, f);
+    } else {
+      for (const auto& edge : graph.get_in_neighbors(vertex)) {
+        f(edge);
+      }
+    }
+  }
 }  // namespace grafology
 
 namespace std {
@@ -0,0 +1,314 @@
+#pragma once
+#include "graph_traits.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace grafology {
+    /**
+     * @brief A d-ary min heap of vertices with a decrease-key operation
+     * @details Each vertex is stored at most once: its position in the heap is kept in an array
+     * indexed by the vertex, so a key can be decreased in place instead of pushing a duplicate.
+     * So the heap never holds more than n_vertices entries.
+     * @tparam key_t the type of the priorities
+     * @tparam D the arity of the heap. A larger arity makes the tree shallower (cheaper decrease-key)
+     * but each pop compares more children.
+     */
+    template <typename key_t, unsigned D = 4>
+    class IndexedDAryHeap {
+        static_assert(D >= 2, "The arity of the heap must be at least 2");
+        static constexpr std::size_t NPOS {std::numeric_limits<std::size_t>::max()};
+
+    public:
+        struct HeapEntry {
+            key_t key;
+            vertex_t vertex;
+        };
+
+        IndexedDAryHeap(std::size_t n_vertices)
+        : _positions(n_vertices, NPOS) {}
+
+        bool empty() const { return _heap.empty(); }
+
+        std::size_t size() const { return _heap.size(); }
+
+        /** @brief the number of vertices which can be stored in the heap */
+        std::size_t capacity() const { return _positions.size(); }
+
+        bool contains(vertex_t v) const {
+            assert(v < _positions.size());
+            return _positions[v] != NPOS;
+        }
+
+        key_t key(vertex_t v) const {
+            assert(contains(v));
+            return _heap[_positions[v]].key;
+        }
+
+        /** @brief the entry with the smallest key */
+        const HeapEntry& top() const {
+            assert(!empty());
+            return _heap.front();
+        }
+
+        void push(vertex_t v, key_t key) {
+            assert(!contains(v));
+            _positions[v] = _heap.size();
+            _heap.push_back({key, v});
+            sift_up(_heap.size() - 1);
+        }
+
+        /** @brief decrease the key of a vertex already in the heap */
+        void decrease(vertex_t v, key_t key) {
+            assert(contains(v) && !(_heap[_positions[v]].key < key));
+            _heap[_positions[v]].key = key;
+            sift_up(_positions[v]);
+        }
+
+        /**
+         * @brief push a vertex or decrease its key if it is already in the heap
+         * @return false if the vertex is already in the heap with a key lower or equal to key
+         */
+        bool push_or_decrease(vertex_t v, key_t key) {
+            if (!contains(v)) {
+                push(v, key);
+                return true;
+            }
+            if (key < _heap[_positions[v]].key) {
+                decrease(v, key);
+                return true;
+            }
+            return false;
+        }
+
+        HeapEntry pop() {
+            assert(!empty());
+            auto res = _heap.front();
+            _positions[res.vertex] = NPOS;
+            auto last = _heap.back();
+            _heap.pop_back();
+            if (!_heap.empty()) {
+                _heap.front() = last;
+                _positions[last.vertex] = 0;
+                sift_down(0);
+            }
+            return res;
+        }
+
+        /** @brief remove all the entries. The cost is proportional to the number of entries, not to the capacity */
+        void clear() {
+            for (const auto& entry : _heap) {
+                _positions[entry.vertex] = NPOS;
+            }
+            _heap.clear();
+        }
+
+    private:
+        void sift_up(std::size_t pos) {
+            auto entry = _heap[pos];
+            while (pos > 0) {
+                auto parent = (pos - 1) / D;
+                if (!(entry.key < _heap[parent].key)) {
+                    break;
+                }
+                move_to(pos, _heap[parent]);
+                pos = parent;
+            }
+            move_to(pos, entry);
+        }
+
+        void sift_down(std::size_t pos) {
+            auto entry = _heap[pos];
+            const auto n = _heap.size();
+            while (true) {
+                auto first_child = pos * D + 1;
+                if (first_child >= n) {
+                    break;
+                }
+                auto last_child = std::min(first_child + D, n);
+                auto best = first_child;
+                for (auto child = first_child + 1; child < last_child; ++child) {
+                    if (_heap[child].key < _heap[best].key) {
+                        best = child;
+                    }
+                }
+                if (!(_heap[best].key < entry.key)) {
+                    break;
+                }
+                move_to(pos, _heap[best]);
+                pos = best;
+            }
+            move_to(pos, entry);
+        }
+
+        void move_to(std::size_t pos, const HeapEntry& entry) {
+            _heap[pos] = entry;
+            _positions[entry.vertex] = pos;
+        }
+
+        std::vector<HeapEntry> _heap;
+        // the position of each vertex in _heap (NPOS if it is not in the heap)
+        std::vector<std::size_t> _positions;
+    };
+
+    /**
+     * @brief A monotone radix heap of vertices with integral keys and a decrease-key operation
+     * @details The heap is monotone: a key can't be lower than the last popped key, which is the case
+     * for the distances of Dijkstra's algorithm. A vertex is stored in the bucket given by the highest
+     * bit which differs between its key and the last popped key. So pushing or decreasing a key is O(1)
+     * and, as the keys only go down the buckets, each entry is moved at most once per bit of the key.
+     * No key comparison is done except for finding the minimum of a bucket.
+     * @remark Like IndexedDAryHeap, each vertex is stored at most once. The keys must be positive.
+     */
+    template <std::integral key_t>
+    class IndexedRadixHeap {
+        using ukey_t = std::make_unsigned_t<key_t>;
+        static constexpr std::size_t N_BUCKETS = std::numeric_limits<ukey_t>::digits + 1;
+        static constexpr unsigned char NO_BUCKET = std::numeric_limits<unsigned char>::max();
+
+    public:
+        struct HeapEntry {
+            key_t key;
+            vertex_t vertex;
+        };
+
+        IndexedRadixHeap(std::size_t n_vertices)
+        : _positions(n_vertices, {0, NO_BUCKET}) {}
+
+        bool empty() const { return _size == 0; }
+
+        std::size_t size() const { return _size; }
+
+        /** @brief the number of vertices which can be stored in the heap */
+        std::size_t capacity() const { return _positions.size(); }
+
+        bool contains(vertex_t v) const {
+            assert(v < _positions.size());
+            return _positions[v].bucket != NO_BUCKET;
+        }
+
+        key_t key(vertex_t v) const {
+            assert(contains(v));
+            return _buckets[_positions[v].bucket][_positions[v].index].key;
+        }
+
+        void push(vertex_t v, key_t key) {
+            assert(!contains(v));
+            insert({key, v});
+            ++_size;
+        }
+
+        /** @brief decrease the key of a vertex already in the heap */
+        void decrease(vertex_t v, key_t key) {
+            assert(contains(v) && !(this->key(v) < key));
+            erase(v);
+            insert({key, v});
+        }
+
+        /**
+         * @brief push a vertex or decrease its key if it is already in the heap
+         * @return false if the vertex is already in the heap with a key lower or equal to key
+         */
+        bool push_or_decrease(vertex_t v, key_t key) {
+            if (!contains(v)) {
+                push(v, key);
+                return true;
+            }
+            if (key < this->key(v)) {
+                decrease(v, key);
+                return true;
+            }
+            return false;
+        }
+
+        HeapEntry pop() {
+            assert(!empty());
+            if (_buckets[0].empty()) {
+                // the minimum of the first non empty bucket becomes the new reference
+                // and the entries of this bucket are spread in the lower buckets
+                std::size_t b = 1;
+                while (_buckets[b].empty()) {
+                    ++b;
+                }
+                auto min = std::ranges::min_element(_buckets[b], {}, &HeapEntry::key);
+                _last = static_cast<ukey_t>(min->key);
+                _spread.swap(_buckets[b]);
+                for (const auto& entry : _spread) {
+                    insert(entry);
+                }
+                _spread.clear();
+            }
+            auto res = _buckets[0].back();
+            _buckets[0].pop_back();
+            _positions[res.vertex].bucket = NO_BUCKET;
+            --_size;
+            return res;
+        }
+
+        /** @brief remove all the entries. The cost is proportional to the number of entries, not to the capacity */
+        void clear() {
+            for (auto& bucket : _buckets) {
+                for (const auto& entry : bucket) {
+                    _positions[entry.vertex].bucket = NO_BUCKET;
+                }
+                bucket.clear();
+            }
+            _size = 0;
+            _last = 0;
+        }
+
+    private:
+        struct Position {
+            std::size_t index;
+            unsigned char bucket;
+        };
+
+        void insert(const HeapEntry& entry) {
+            auto key = static_cast<ukey_t>(entry.key);
+            assert(entry.key >= 0 && key >= _last);
+            auto b = static_cast<unsigned char>(std::bit_width(static_cast<ukey_t>(key ^ _last)));
+            _positions[entry.vertex] = {_buckets[b].size(), b};
+            _buckets[b].push_back(entry);
+        }
+
+        void erase(vertex_t v) {
+            auto [index, b] = _positions[v];
+            auto& bucket = _buckets[b];
+            bucket[index] = bucket.back();
+            _positions[bucket[index].vertex].index = index;
+            bucket.pop_back();
+            _positions[v].bucket = NO_BUCKET;
+        }
+
+        std::array<std::vector<HeapEntry>, N_BUCKETS> _buckets;
+        // the bucket and the index in the bucket of each vertex
+        std::vector<Position> _positions;
+        // the entries being moved to the lower buckets (kept for reusing its memory)
+        std::vector<HeapEntry> _spread;
+        // the last popped key
+        ukey_t _last = 0;
+        std::size_t _size = 0;
+    };
+
+    /**
+     * @brief The priority queue used by Dijkstra's algorithm
+     * @details The distances popped by Dijkstra's algorithm never decrease, so integral distances
+     * can be queued in a radix heap which doesn't compare keys. Otherwise a d-ary heap is used.
+     */
+    template <Number weight_t>
+    struct DijkstraHeap {
+        using type = IndexedDAryHeap<weight_t>;
+    };
+
+    template <Number weight_t>
+    requires std::integral<weight_t>
+    struct DijkstraHeap<weight_t> {
+        using type = IndexedRadixHeap<weight_t>;
+    };
+} // namespace grafology
@@ -0,0 +1,130 @@
+#pragma once
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <new>
+
+namespace grafology::internal {
+    /**
+     * @brief A thread local pool of memory blocks used for the coroutine frames of the generators
+     * @details The blocks are grouped by size classes (powers of 2 from 64 bytes to 8 KB). When a
+     * block is released, it is kept in the free list of the current thread for its size class so
+     * that the next generator of a similar size doesn't need to call the global heap.
+     * Larger blocks are directly allocated with the global operator new.
+     * @remark A block can be released by another thread than the one which allocated it: it will
+     * then be recycled by the releasing thread.
+     */
+    class FramePool {
+    public:
+        static constexpr std::size_t MIN_BLOCK_SIZE = 64;
+        static constexpr std::size_t N_SIZE_CLASSES = 8;
+        /** @brief the maximum number of free blocks kept per size class and per thread */
+        static constexpr unsigned MAX_FREE_BLOCKS = 64;
+
+        static void* allocate(std::size_t bytes) {
+            auto size_class = get_size_class(bytes);
+            if (size_class == N_SIZE_CLASSES || _is_destroyed) {
+                return ::operator new(size_class == N_SIZE_CLASSES ? bytes : MIN_BLOCK_SIZE << size_class);
+            }
+            auto& lists = free_lists();
+            if (auto block = lists.heads[size_class]; block != nullptr) {
+                lists.heads[size_class] = block->next;
+                --lists.counts[size_class];
+                return block;
+            }
+            return ::operator new(MIN_BLOCK_SIZE << size_class);
+        }
+
+        static void deallocate(void* p, std::size_t bytes) noexcept {
+            auto size_class = get_size_class(bytes);
+            if (size_class == N_SIZE_CLASSES) {
+                ::operator delete(p);
+                return;
+            }
+            if (_is_destroyed) {
+                // the thread is exiting and its free lists are already released
+                ::operator delete(p);
+                return;
+            }
+            auto& lists = free_lists();
+            if (lists.counts[size_class] == MAX_FREE_BLOCKS) {
+                ::operator delete(p);
+                return;
+            }
+            auto block = static_cast<Block*>(p);
+            block->next = lists.heads[size_class];
+            lists.heads[size_class] = block;
+            ++lists.counts[size_class];
+        }
+
+        /** @brief the number of free blocks kept by the current thread for a size class */
+        static unsigned n_free_blocks(std::size_t size_class) {
+            return free_lists().counts[size_class];
+        }
+
+        /** @brief the size class of an allocation or N_SIZE_CLASSES if it is too large */
+        static constexpr std::size_t get_size_class(std::size_t bytes) {
+            if (bytes <= MIN_BLOCK_SIZE) {
+                return 0;
+            }
+            auto size_class = std::bit_width(bytes - 1) - std::bit_width(MIN_BLOCK_SIZE - 1);
+            return size_class < N_SIZE_CLASSES ? size_class : N_SIZE_CLASSES;
+        }
+
+    private:
+        struct Block {
+            Block* next;
+        };
+
+        struct FreeLists {
+            std::array<Block*, N_SIZE_CLASSES> heads{};
+            std::array<unsigned, N_SIZE_CLASSES> counts{};
+
+            ~FreeLists() {
+                for (auto block : heads) {
+                    while (block != nullptr) {
+                        auto next = block->next;
+                        ::operator delete(block);
+                        block = next;
+                    }
+                }
+                _is_destroyed = true;
+            }
+        };
+
+        static FreeLists& free_lists() {
+            thread_local FreeLists lists;
+            return lists;
+        }
+
+        // trivially destructible, so it can still be read after the destruction of the free lists
+        static inline thread_local bool _is_destroyed = false;
+    };
+
+    /**
+     * @brief The allocator used by default for the coroutine frames of the generators
+     * @see FramePool
+     */
+    template <typename T>
+    struct frame_allocator {
+        using value_type = T;
+
+        frame_allocator() = default;
+        template <typename U>
+        frame_allocator(const frame_allocator<U>&) noexcept {}
+
+        T* allocate(std::size_t n) {
+            static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+            return static_cast<T*>(FramePool::allocate(n * sizeof(T)));
+        }
+
+        void deallocate(T* p, std::size_t n) noexcept {
+            FramePool::deallocate(p, n * sizeof(T));
+        }
+
+        template <typename U>
+        bool operator==(const frame_allocator<U>&) const noexcept {
+            return true;
+        }
+    };
+}  // namespace grafology::internal
@@ -5,15 +5,24 @@
 // g++ > 14.0 is required
 // Clang > 19.0 is required
 
+// The allocator used for the coroutine frames of all the generators returned by the library.
+// By default, the frames are recycled by a thread local pool (see frame_allocator.h).
+// Define it as void for using the global heap. It must be the same for all the translation units.
+#ifndef GRAFOLOGY_GENERATOR_ALLOCATOR
+    #include "frame_allocator.h"
+    #define GRAFOLOGY_GENERATOR_ALLOCATOR grafology::internal::frame_allocator<std::byte>
+#endif
+
 #if __has_include(<generator>)
     #include <generator>
-    template<typename _Ref, typename _Val = void, typename _Alloc = void>
+    template<typename _Ref, typename _Val = void, typename _Alloc = GRAFOLOGY_GENERATOR_ALLOCATOR>
     using generator = std::generator<_Ref, _Val, _Alloc>;
 #else
 #   if defined(_MSC_VER)
         // don't know when generator will be available in MSVC ?
         #include <experimental/generator>
-        template <class _Ty, class _Alloc = std::allocator<char>>
+        #include <type_traits>
+        template <class _Ty, class _Alloc = std::conditional_t<std::is_void_v<GRAFOLOGY_GENERATOR_ALLOCATOR>, std::allocator<char>, GRAFOLOGY_GENERATOR_ALLOCATOR>>
         using generator = std::experimental::generator<_Ty, _Alloc>;
 #   else
         static_assert(false, "std::generator is not available");
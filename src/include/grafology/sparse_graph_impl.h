@@ -4,6 +4,9 @@
 namespace grafology {
     /**
      * @brief A sparse graph implementation which use an adjacency list
+     * @details For directed graphs, an index of the incoming edges can be maintained (see the
+     * constructor parameter with_in_edges). Then in_degree() and the in-neighbors queries cost
+     * O(in-degree) instead of O(V+E), at the cost of storing each edge twice.
      * @warning Once built, the graph capacity cannot be changed.
      */
     template<Number weight_t>
@@ -12,13 +15,17 @@ namespace grafology {
         using edge_lt = edge_t<weight_t>;
         using weight_lt = weight_t;
 
-        SparseGraphImpl(unsigned n_max_vertices, unsigned n_vertices, bool is_directed) :
+        SparseGraphImpl(unsigned n_max_vertices, unsigned n_vertices, bool is_directed, bool with_in_edges = false) :
           _is_directed(is_directed),
+          _has_in_edges(is_directed && with_in_edges),
           _n_max_vertices(n_max_vertices), 
           _n_vertices(n_vertices),
           _adjacency_list(_n_max_vertices) {
             assert(n_vertices <= n_max_vertices);
             _adjacency_list.reserve(_n_max_vertices);
+            if (_has_in_edges) {
+                _in_adjacency_list.resize(_n_max_vertices);
+            }
         }
         SparseGraphImpl(const SparseGraphImpl&) = default;
         SparseGraphImpl(SparseGraphImpl&&) = default;
@@ -33,6 +40,18 @@ namespace grafology {
 
         bool is_directed() const { return _is_directed; }
 
+        /** @brief true if the index of the incoming edges is maintained */
+        bool has_in_edges() const { return _has_in_edges; }
+
+        /** @brief the memory (in bytes) used by the index of the incoming edges */
+        std::size_t in_edges_memory_usage() const {
+            std::size_t usage = _in_adjacency_list.capacity() * sizeof(FlatIndexMap<weight_t>);
+            for (const auto& in_edges : _in_adjacency_list) {
+                usage += in_edges.capacity() * sizeof(typename FlatIndexMap<weight_t>::MapEntry);
+            }
+            return usage;
+        }
+
         weight_t operator()(vertex_t i, vertex_t j) const { 
             assert(i < _n_vertices && j < _n_vertices);
              return _adjacency_list[i].get(j);
@@ -71,16 +90,21 @@ namespace grafology {
 
         void set_edge(vertex_t start, vertex_t end, weight_t weight) {
             assert(start < _n_vertices && end < _n_vertices);
-            if (weight == 0 && _adjacency_list[start].get(end) != 0) {
+            // a zero weight removes the edge (and must not insert one if there is no edge)
+            if (weight == 0) {
                 _adjacency_list[start].remove(end);
                 if (!_is_directed) {
                     _adjacency_list[end].remove(start);
+                } else if (_has_in_edges) {
+                    _in_adjacency_list[end].remove(start);
                 }
                 return;
             }
             _adjacency_list[start].set(end, weight);
             if (!_is_directed) {
                 _adjacency_list[end].set(start, weight);
+            } else if (_has_in_edges) {
+                _in_adjacency_list[end].set(start, weight);
             }
         }
 
@@ -89,10 +113,56 @@ namespace grafology {
             set_edge(edge.start, edge.end, edge.weight);
         }
         
+        /**
+         * @brief Batch set edges
+         * @details The edges are bucketed by start vertex (counting sort) then each adjacency list
+         * is filled in a single pass. So this is O(E + k.log(k)) instead of O(k.degree) for k calls
+         * to set_edge(). When an edge is given several times, the last weight wins.
+         */
         template<input_iterator_value<edge_lt> I, std::sentinel_for<I> S>
         void set_edges(I first, S last) {
+            using entry_t = typename FlatIndexMap<weight_t>::MapEntry;
+            std::vector<edge_lt> edges;
             for (auto it = first; it != last; ++it) {
-                set_edge(it->start, it->end, it->weight);
+                edge_lt edge = *it;
+                assert(edge.start < _n_vertices && edge.end < _n_vertices);
+                edges.push_back(edge);
+                if (!_is_directed && edge.start != edge.end) {
+                    edges.push_back({.start = edge.end, .end = edge.start, .weight = edge.weight});
+                }
+            }
+            std::vector<std::size_t> offsets(_n_vertices + 1, 0);
+            for (const auto& edge : edges) {
+                ++offsets[edge.start + 1];
+            }
+            for (std::size_t i = 1; i < offsets.size(); ++i) {
+                offsets[i] += offsets[i - 1];
+            }
+            // the counting sort is stable: the input order is preserved in each bucket
+            std::vector<entry_t> entries(edges.size());
+            std::vector<std::size_t> cursor(offsets.begin(), offsets.end() - 1);
+            for (const auto& edge : edges) {
+                entries[cursor[edge.start]++] = {edge.end, edge.weight};
+            }
+            for (vertex_t i = 0; i < _n_vertices; ++i) {
+                _adjacency_list[i].merge(entries.begin() + offsets[i], entries.begin() + offsets[i + 1]);
+            }
+            if (_has_in_edges) {
+                // same thing for the incoming edges, bucketed by end vertex
+                std::ranges::fill(offsets, 0);
+                for (const auto& edge : edges) {
+                    ++offsets[edge.end + 1];
+                }
+                for (std::size_t i = 1; i < offsets.size(); ++i) {
+                    offsets[i] += offsets[i - 1];
+                }
+                cursor.assign(offsets.begin(), offsets.end() - 1);
+                for (const auto& edge : edges) {
+                    entries[cursor[edge.end]++] = {edge.start, edge.weight};
+                }
+                for (vertex_t i = 0; i < _n_vertices; ++i) {
+                    _in_adjacency_list[i].merge(entries.begin() + offsets[i], entries.begin() + offsets[i + 1]);
+                }
             }
         }
 
@@ -102,9 +172,7 @@ namespace grafology {
         }
 
         void set_edges(generator<edge_lt>& g) {
-            for (const auto& edge : g) {
-                set_edge(edge);
-            }
+            set_edges(g.begin(), g.end());
         }
 
         std::size_t degree(vertex_t vertex) const {
@@ -117,6 +185,9 @@ namespace grafology {
             if (!is_directed()) {
                 return degree(vertex);
             }
+            if (_has_in_edges) {
+                return _in_adjacency_list[vertex].size();
+            }
             std::size_t in_degree = 0;
             for (const auto& neighbors: _adjacency_list) {
                 for (const auto& neighbor: neighbors) {
@@ -147,8 +218,53 @@ namespace grafology {
             }
         }
 
+        template<typename F>
+        void for_each_neighbor(vertex_t vertex, F&& f) const {
+            assert(vertex < _n_vertices);
+            for (const auto& edge : _adjacency_list[vertex]) {
+                if (edge.vertex != vertex) {
+                    f(edge_lt{.start = vertex, .end = edge.vertex, .weight = edge.weight});
+                }
+            }
+        }
+
+        template<typename F>
+        void for_each_in_neighbor(vertex_t vertex, F&& f) const {
+            assert(vertex < _n_vertices);
+            if (!_is_directed) {
+                for_each_neighbor(vertex, [&](const edge_lt& edge) {
+                    f(edge_lt{.start = edge.end, .end = vertex, .weight = edge.weight});
+                });
+                return;
+            }
+            if (_has_in_edges) {
+                for (const auto& edge : _in_adjacency_list[vertex]) {
+                    if (edge.vertex != vertex) {
+                        f(edge_lt{.start = edge.vertex, .end = vertex, .weight = edge.weight});
+                    }
+                }
+                return;
+            }
+            for (vertex_t i = 0; i < _n_vertices; ++i) {
+                if (i != vertex) {
+                    auto weight = _adjacency_list[i].get(vertex);
+                    if (weight != 0) {
+                        f(edge_lt{.start = i, .end = vertex, .weight = weight});
+                    }
+                }
+            }
+        }
+
         generator<vertex_t> get_raw_in_neighbors(vertex_t vertex) const {
             assert(vertex < _n_vertices);
+            if (_has_in_edges) {
+                for (const auto& edge : _in_adjacency_list[vertex]) {
+                    if (edge.vertex != vertex) {
+                        co_yield edge.vertex;
+                    }
+                }
+                co_return;
+            }
             for (unsigned i = 0; i < size(); ++i) {
                 if (i == vertex) {
                     continue;
@@ -163,6 +279,14 @@ namespace grafology {
 
         generator<edge_lt> get_in_neighbors(vertex_t vertex) const {
             assert(vertex < _n_vertices);
+            if (_has_in_edges) {
+                for (const auto& edge : _in_adjacency_list[vertex]) {
+                    if (edge.vertex != vertex) {
+                        co_yield {.start = edge.vertex, .end = vertex, .weight = edge.weight};
+                    }
+                }
+                co_return;
+            }
             for (unsigned i = 0; i < size(); ++i) {
                 if (i == vertex) {
                     continue;
@@ -176,6 +300,11 @@ namespace grafology {
         }
 
         SparseGraphImpl<weight_t> invert() const {
+            if (_has_in_edges) {
+                SparseGraphImpl inverted(*this);
+                std::swap(inverted._adjacency_list, inverted._in_adjacency_list);
+                return inverted;
+            }
             SparseGraphImpl inverted(_n_max_vertices, _n_vertices, _is_directed);
             for (unsigned i = 0; i < _n_vertices; i++) {
                 for (const auto& edge : _adjacency_list[i]) {
@@ -207,9 +336,12 @@ namespace grafology {
 
    private:
         bool _is_directed;
+        bool _has_in_edges;
         unsigned _n_max_vertices;
         unsigned _n_vertices;
         std::vector<FlatIndexMap<weight_t>> _adjacency_list;
+        // the incoming edges (only for directed graphs)
+        std::vector<FlatIndexMap<weight_t>> _in_adjacency_list;
     };
 
 } // namespace grafology
@@ -1,9 +1,14 @@
+#include <grafology/algorithms/all_pairs_shortest_paths.h>
 #include <grafology/algorithms/all_shortest_paths.h>
 #include <grafology/algorithms/articulation_points.h>
 #include <grafology/algorithms/breath_first_search.h>
 #include <grafology/algorithms/bridges.h>
+#include <grafology/algorithms/contraction_hierarchies.h>
 #include <grafology/algorithms/depth_first_search.h>
+#include <grafology/algorithms/landmarks.h>
 #include <grafology/algorithms/maximum_flow.h>
+#include <grafology/algorithms/minimum_cost_flow.h>
+#include <grafology/algorithms/minimum_cut.h>
 #include <grafology/algorithms/minimum_spanning_tree.h>
 #include <grafology/algorithms/shortest_path.h>
 #include <grafology/algorithms/strongly_connected_components.h>
@@ -241,13 +246,24 @@ TEMPLATE_TEST_CASE(
     g.add_vertices(vertices_init);
     g.set_edges(edges_init);
 
-    for (auto use_dijkstra_algo : {true, false}) {
-        CAPTURE(use_dijkstra_algo);
-        if (!use_dijkstra_algo and !directed) {
+    for (auto algo : {"dijkstra", "BF", "SPFA"}) {
+        CAPTURE(algo);
+        if (algo != std::string_view("dijkstra") and !directed) {
             // Bellman-Ford only works with directed graphs
             continue;
         }
-        auto paths = g::all_shortest_paths(g, {0});
+        auto get_paths = [&] {
+            if constexpr (TestType::is_directed()) {
+                if (algo == std::string_view("BF")) {
+                    return g::all_shortest_path_BF(g, {0});
+                }
+                if (algo == std::string_view("SPFA")) {
+                    return g::all_shortest_paths_SPFA(g, {0});
+                }
+            }
+            return g::all_shortest_paths(g, {0});
+        };
+        auto paths = get_paths();
         for (int i = 0; i < n_vertices; ++i) {
             CAPTURE(i);
             CHECK(paths.get_distance(vertices_init[i]) == expected_distances[directed][i]);
@@ -272,6 +288,40 @@ TEMPLATE_TEST_CASE(
             }
         }
     }
+
+    // the vertices within a distance of 12
+    auto nearby = g::all_shortest_paths(g, TestVertex{0}, {.max_distance = 12});
+    for (int i = 0; i < n_vertices; ++i) {
+        CAPTURE(i);
+        CHECK(nearby.is_reachable(vertices_init[i]) == (expected_distances[directed][i] <= 12));
+    }
+    weight_t last_distance = 0;
+    for (const auto& [v, d] : nearby.get_vertices()) {
+        CHECK(d == nearby.get_distance(v));
+        CHECK(d >= last_distance);
+        last_distance = d;
+    }
+    for (const auto& [idx, v] : std::views::enumerate(nearby.get_path(vertices_init[2]))) {
+        CHECK((v == expected_path_to_8[directed][idx]));
+    }
+    auto to_5 = g::all_shortest_paths(g, TestVertex{0}, {.targets = {vertices_init[5]}});
+    CHECK(to_5.get_distance(vertices_init[5]) == expected_distances[directed][5]);
+    CHECK(!to_5.is_reachable(vertices_init[4]));
+
+    // all the pairs at once
+    for (bool johnson : {false, true}) {
+        CAPTURE(johnson);
+        auto all_paths = johnson ? g::all_pairs_shortest_paths_johnson(g, true)
+                                 : g::all_pairs_shortest_paths_FW(g, true);
+        for (int i = 0; i < n_vertices; ++i) {
+            CAPTURE(i);
+            CHECK(all_paths.get_distance({0}, vertices_init[i]) == expected_distances[directed][i]);
+            CHECK(all_paths.is_reachable({0}, vertices_init[i]) == !unreachable.contains(vertices_init[i]));
+        }
+        for (const auto& [idx, v] : std::views::enumerate(all_paths.get_path({0}, vertices_init[8]))) {
+            CHECK((v == expected_path_to_8[directed][idx]));
+        }
+    }
 }
 
 TEMPLATE_TEST_CASE(
@@ -321,10 +371,13 @@ TEMPLATE_TEST_CASE(
         };
 
     bool directed = g.is_directed();
+    auto hierarchy = g::contraction_hierarchy(g);
+    auto landmarks = g::landmark_heuristic(g, 2);
     for (const auto& [start, end, expected_path] : expected[directed]) {
         CAPTURE(start, end, directed);
-        // build our cost function from the real distances
-        auto paths_to_end = g::all_shortest_paths(g, end);
+        // build our cost function from the real distances to end (i.e. from end in the inverted graph)
+        auto inverted = g.invert();
+        auto paths_to_end = g::all_shortest_paths(inverted, end);
         auto cost_function = [&paths_to_end](const TestVertex& i, const TestVertex& /* j */) {
             return paths_to_end.get_distance(i);
         };
@@ -332,6 +385,26 @@ TEMPLATE_TEST_CASE(
         auto path = g::shortest_path(g, start, end, cost_function);
         auto v_path = path.get_path() | std::ranges::to<std::vector>();
         CHECK(v_path == expected_path);
+
+        auto bidirectional_path = g::bidirectional_shortest_path(g, start, end);
+        CHECK((bidirectional_path.get_path() | std::ranges::to<std::vector>()) == expected_path);
+        auto inverted_path = g::bidirectional_shortest_path(g, inverted, start, end);
+        CHECK((inverted_path.get_path() | std::ranges::to<std::vector>()) == expected_path);
+
+        // the bidirectional A* also needs the distances from start
+        auto paths_from_start = g::all_shortest_paths(g, start);
+        auto consistent_cost_function = [&](const TestVertex& i, const TestVertex& j) {
+            return j == end ? paths_to_end.get_distance(i) : paths_from_start.get_distance(j);
+        };
+        auto a_star_path = g::bidirectional_shortest_path(g, start, end, consistent_cost_function);
+        CHECK((a_star_path.get_path() | std::ranges::to<std::vector>()) == expected_path);
+
+        auto landmarks_path = g::shortest_path(g, start, end, landmarks);
+        CHECK((landmarks_path.get_path() | std::ranges::to<std::vector>()) == expected_path);
+
+        auto hierarchy_path = hierarchy.shortest_path(start, end);
+        CHECK((hierarchy_path.get_path() | std::ranges::to<std::vector>()) == expected_path);
+        CHECK(hierarchy.distance(start, end) == (expected_path.empty() ? D_INFINITY : std::get<1>(expected_path.back())));
     }
 }
 
@@ -350,6 +423,81 @@ TEMPLATE_TEST_CASE("Graphs - Max Flow", "[graphs-algos]", DirectedDenseGraph, Di
     auto max_flow = g::maximum_flow(g, {0}, {5});
     CAPTURE(max_flow);
     CHECK(max_flow == 23);
+
+    for (bool dinic : {false, true}) {
+        auto res = dinic ? g::maximum_flow_dinic(g, {0}, {5}) : g::maximum_flow_push_relabel(g, {0}, {5});
+        CHECK(res.value == 23);
+        auto flow = [&](const TestVertex& u, const TestVertex& v) {
+            return res.flows.impl().weight(res.flows.get_internal_index(u), res.flows.get_internal_index(v));
+        };
+        CHECK(flow({0}, {1}) + flow({0}, {2}) == 23);
+        CHECK(flow({3}, {5}) + flow({4}, {5}) == 23);
+        CHECK(flow({4}, {5}) == 4);
+    }
+
+    auto cut = g::minimum_cut(g, {0}, {5});
+    CHECK(cut.value == 23);
+    CHECK(std::ranges::find(cut.vertices, TestVertex{0}) != cut.vertices.end());
+    CHECK(std::ranges::find(cut.vertices, TestVertex{5}) == cut.vertices.end());
+    int value = 0;
+    for (const auto& edge : cut.edges) {
+        value += edge.weight;
+    }
+    CHECK(value == 23);
+}
+
+TEMPLATE_TEST_CASE("Graphs - Min Cost Flow", "[graphs-algos]", DirectedDenseGraph, DirectedSparseGraph) {
+    int n_vertices = 4;
+    std::vector<TestVertex> vertices_init{{generate_test_vertices_list(n_vertices)}};
+    std::vector<TestEdge> capacities_init = {
+        {{0}, {1}, 2}, {{0}, {2}, 2}, {{1}, {3}, 1}, {{1}, {2}, 2}, {{2}, {3}, 3},
+    };
+    std::vector<TestEdge> costs_init = {
+        {{0}, {1}, 1}, {{0}, {2}, 2}, {{1}, {3}, 1}, {{2}, {3}, 1},
+    };
+
+    TestType g(n_vertices);
+    g.add_vertices(vertices_init);
+    g.set_edges(capacities_init);
+    // the same vertices, added in another order
+    TestType costs(n_vertices);
+    for (int v = n_vertices - 1; v >= 0; --v) {
+        costs.add_vertex({v});
+    }
+    costs.set_edges(costs_init);
+
+    auto res = g::minimum_cost_flow(g, costs, {0}, {3});
+    CHECK(res.value == 4);
+    CHECK(res.cost == 10);
+    res = g::minimum_cost_flow(g, costs, {0}, {3}, 2);
+    CHECK(res.value == 2);
+    CHECK(res.cost == 4);
+    auto flow = [&](const TestVertex& u, const TestVertex& v) {
+        return res.flows.impl().weight(res.flows.get_internal_index(u), res.flows.get_internal_index(v));
+    };
+    CHECK(flow({0}, {1}) == 2);
+    CHECK(flow({1}, {2}) == 1);
+    CHECK(flow({2}, {3}) == 1);
+}
+
+TEMPLATE_TEST_CASE("Graphs - Min Cut", "[graphs-algos]", UndirectedDenseGraph, UndirectedSparseGraph) {
+    // two triangles joined by a light edge
+    int n_vertices = 6;
+    std::vector<TestVertex> vertices_init{{generate_test_vertices_list(n_vertices)}};
+    std::vector<TestEdge> edges_init = {
+        {{0}, {1}, 4}, {{1}, {2}, 4}, {{2}, {0}, 4}, {{3}, {4}, 4}, {{4}, {5}, 4}, {{5}, {3}, 4}, {{2}, {3}, 1},
+    };
+
+    TestType g(n_vertices);
+    g.add_vertices(vertices_init);
+    g.set_edges(edges_init);
+
+    for (const auto& cut : {g::minimum_cut_stoer_wagner(g), g::minimum_cut_karger_stein(g)}) {
+        CHECK(cut.value == 1);
+        CHECK(cut.vertices.size() == 3);
+        REQUIRE(cut.edges.size() == 1);
+        CHECK(std::unordered_set<TestVertex>{cut.edges[0].start, cut.edges[0].end} == std::unordered_set<TestVertex>{{2}, {3}});
+    }
 }
 
 TEMPLATE_TEST_CASE(
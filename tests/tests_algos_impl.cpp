@@ -1,15 +1,23 @@
+#include <grafology/algorithms/all_pairs_shortest_paths.h>
 #include <grafology/algorithms/all_shortest_paths.h>
 #include <grafology/algorithms/articulation_points.h>
 #include <grafology/algorithms/breath_first_search.h>
 #include <grafology/algorithms/bridges.h>
+#include <grafology/algorithms/contraction_hierarchies.h>
+#include <grafology/algorithms/cycles.h>
+#include <grafology/algorithms/delta_stepping.h>
 #include <grafology/algorithms/depth_first_search.h>
+#include <grafology/algorithms/landmarks.h>
 #include <grafology/algorithms/maximum_flow.h>
+#include <grafology/algorithms/minimum_cost_flow.h>
+#include <grafology/algorithms/minimum_cut.h>
 #include <grafology/algorithms/minimum_spanning_tree.h>
 #include <grafology/algorithms/shortest_path.h>
 #include <grafology/algorithms/strongly_connected_components.h>
 #include <grafology/algorithms/topological_sort.h>
 #include <grafology/algorithms/transitive_closure.h>
 #include <catch2/catch_template_test_macros.hpp>
+#include <mutex>
 #include <print>
 #include <set>
 #include <unordered_set>
@@ -22,10 +30,14 @@ using vertex_t = g::vertex_t;
 using step_t = g::step_t<weight_t>;
 using DenseGraphImpl = g::DenseGraphImpl<weight_t>;
 using SparseGraphImpl = g::SparseGraphImpl<weight_t>;
+using CSRGraphImpl = g::CSRGraphImpl<weight_t>;
+using BitDenseGraphImpl = g::BitDenseGraphImpl<weight_t>;
 static constexpr auto D_INFINITY = edge_t::D_INFINITY;
 
 static_assert(g::GraphImpl<DenseGraphImpl, weight_t>);
 static_assert(g::GraphImpl<SparseGraphImpl, weight_t>);
+static_assert(g::GraphImpl<CSRGraphImpl, weight_t>);
+static_assert(g::GraphImpl<BitDenseGraphImpl, weight_t>);
 
 namespace {
     constexpr unsigned max_vertices = 11;
@@ -36,9 +48,46 @@ namespace {
         {3, 10, 13}, {5, 8, 13}, {6, 7, 13}, {8, 3, 11}, {8, 7, 15}, {8, 9, 17},
     };
 
+    /**
+     * @brief a sparse graph with two edges from each vertex i, to (7i + 3) % n and to (13i + 1) % n, an edge
+     * of weight 100 to i + 1 every extra_every vertices (never if 0), and no edge to the unreachable vertex
+     */
+    template <typename edge_lt = edge_t>
+    std::vector<edge_lt> make_test_edges(vertex_t n, vertex_t extra_every = 0, vertex_t unreachable = g::INVALID_VERTEX) {
+        using weight_lt = decltype(edge_lt::weight);
+        std::vector<edge_lt> edges;
+        for (vertex_t i = 0; i < n; ++i) {
+            edges.push_back({i, (i * 7 + 3) % n, static_cast<weight_lt>(1 + (i * 31) % 50)});
+            edges.push_back({i, (i * 13 + 1) % n, static_cast<weight_lt>(1 + (i * 17) % 7)});
+            if (extra_every != 0 && i % extra_every == 0) {
+                edges.push_back({i, (i + 1) % n, static_cast<weight_lt>(100)});
+            }
+        }
+        std::erase_if(edges, [&](const auto& e) { return e.end == unreachable; });
+        return edges;
+    }
+
+    /**
+     * @brief n_edges pseudo-random edges between the vertices [0, n), which all end in [0, n_ends), without
+     * loops nor zero weights. The weight of the i-th edge (u, v) is weight(i, u, v)
+     */
+    template <typename edge_lt = edge_t, typename F>
+    std::vector<edge_lt> make_random_edges(vertex_t n, vertex_t n_edges, vertex_t n_ends, F weight) {
+        std::vector<edge_lt> edges;
+        for (vertex_t i = 0; i < n_edges; ++i) {
+            vertex_t u = (i * 7 + 3) % n;
+            vertex_t v = (i * 13 + 1 + i / n) % n_ends;
+            auto w = weight(i, u, v);
+            if (u != v && w != 0) {
+                edges.push_back({u, v, w});
+            }
+        }
+        return edges;
+    }
+
 }  // namespace
 
-TEMPLATE_TEST_CASE("Impl - Topological sort", "[impl-algos]", DenseGraphImpl, SparseGraphImpl) {
+TEMPLATE_TEST_CASE("Impl - Topological sort", "[impl-algos]", DenseGraphImpl, SparseGraphImpl, CSRGraphImpl, BitDenseGraphImpl) {
     const std::vector<std::set<vertex_t>> expected{
         {0, 6}, {2}, {4, 5}, {8}, {3, 7, 9}, {1, 10},
     };
@@ -73,7 +122,7 @@ TEMPLATE_TEST_CASE("Impl - Topological sort", "[impl-algos]", DenseGraphImpl, Sp
     }));
 }
 
-TEMPLATE_TEST_CASE("Impl - DFS", "[impl-algos]", DenseGraphImpl, SparseGraphImpl) {
+TEMPLATE_TEST_CASE("Impl - DFS", "[impl-algos]", DenseGraphImpl, SparseGraphImpl, CSRGraphImpl, BitDenseGraphImpl) {
     const std::vector<vertex_t> expected_directed{0, 2, 5, 8, 9, 7, 3, 10, 1, 4};
     const std::vector<vertex_t> expected_undirected{0, 2, 5, 8, 9, 7, 6, 3, 10, 1, 4};
 
@@ -94,7 +143,7 @@ TEMPLATE_TEST_CASE("Impl - DFS", "[impl-algos]", DenseGraphImpl, SparseGraphImpl
     }
 }
 
-TEMPLATE_TEST_CASE("Impl - BFS", "[impl-algos]", DenseGraphImpl, SparseGraphImpl) {
+TEMPLATE_TEST_CASE("Impl - BFS", "[impl-algos]", DenseGraphImpl, SparseGraphImpl, CSRGraphImpl, BitDenseGraphImpl) {
     const std::vector<vertex_t> expected_directed{0, 1, 2, 3, 4, 5, 10, 8, 7, 9};
     const std::vector<vertex_t> expected_undirected{0, 1, 2, 3, 5, 4, 8, 10, 7, 9, 6};
 
@@ -119,7 +168,9 @@ TEMPLATE_TEST_CASE(
     "Impl - Transitive closure directed",
     "[impl-algos]",
     DenseGraphImpl,
-    SparseGraphImpl
+    SparseGraphImpl,
+    CSRGraphImpl,
+    BitDenseGraphImpl
 ) {
     const std::vector<edge_t> directed_extra_edges{
         {0, 3}, {0, 4},  {0, 5}, {0, 7}, {0, 8}, {0, 9}, {0, 10}, {2, 1}, {2, 8},  {2, 7},
@@ -146,7 +197,9 @@ TEMPLATE_TEST_CASE(
     "Impl - Transitive closure undirected",
     "[impl-algos]",
     DenseGraphImpl,
-    SparseGraphImpl
+    SparseGraphImpl,
+    CSRGraphImpl,
+    BitDenseGraphImpl
 ) {
     TestType g(max_vertices, n_vertices, false);
     g.set_edges(edges_init);
@@ -161,7 +214,63 @@ TEMPLATE_TEST_CASE(
     }
 }
 
-TEMPLATE_TEST_CASE("Impl - MST", "[impl-algos]", DenseGraphImpl, SparseGraphImpl) {
+TEMPLATE_TEST_CASE(
+    "Impl - Transitive closure large graph",
+    "[impl-algos]",
+    DenseGraphImpl,
+    SparseGraphImpl,
+    CSRGraphImpl,
+    BitDenseGraphImpl
+) {
+    // large enough for the rows of the adjacency matrices to be split between several threads
+    constexpr unsigned n = 600;
+    std::vector<edge_t> edges;
+    for (vertex_t i = 0; i < n; ++i) {
+        // a few cycles and chains
+        edges.push_back({i, (i * 7 + 3) % n});
+        if (i % 5 == 0) {
+            edges.push_back({i, (i * 13 + 1) % n, 3});
+        }
+    }
+    edges.push_back({4, 4});
+
+    for (bool is_directed : {true, false}) {
+        CAPTURE(is_directed);
+        TestType g(n, n, is_directed);
+        g.set_edges(edges);
+        g::transitive_closure(g, 4);
+
+        TestType initial(n, n, is_directed);
+        initial.set_edges(edges);
+        for (vertex_t i = 0; i < n; ++i) {
+            // the reachable vertices (at least one edge away) are found with a BFS
+            std::vector<bool> reached(n, false);
+            std::vector<vertex_t> queue{i};
+            while (!queue.empty()) {
+                auto v = queue.back();
+                queue.pop_back();
+                for (vertex_t j = 0; j < n; ++j) {
+                    if (initial.has_edge(v, j) && !reached[j]) {
+                        reached[j] = true;
+                        queue.push_back(j);
+                    }
+                }
+            }
+            std::vector<bool> closed(n, false);
+            for (vertex_t j = 0; j < n; ++j) {
+                closed[j] = g.has_edge(i, j);
+            }
+            CAPTURE(i);
+            CHECK(closed == reached);
+        }
+        // the existing edges keep their weight (not for BitDenseGraphImpl which is unweighted)
+        if constexpr (!std::is_same_v<TestType, BitDenseGraphImpl>) {
+            CHECK(g.weight(0, 1) == 3);
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE("Impl - MST", "[impl-algos]", DenseGraphImpl, SparseGraphImpl, CSRGraphImpl) {
     std::vector<edge_t> edges{
         {0, 1, 5},   {0, 2, 3},   {3, 1, 2},   {4, 1, 6},   {5, 4, 2},
         {5, 3, 1},   {1, 2, 5},   {4, 6, 5},   {6, 7, 5},   {7, 8, 5},
@@ -183,7 +292,7 @@ TEMPLATE_TEST_CASE("Impl - MST", "[impl-algos]", DenseGraphImpl, SparseGraphImpl
     REQUIRE(mst == expected);
 }
 
-TEMPLATE_TEST_CASE("Impl - Dijkstra/BellMan-Ford", "[impl-algos]", DenseGraphImpl, SparseGraphImpl) {
+TEMPLATE_TEST_CASE("Impl - Dijkstra/BellMan-Ford", "[impl-algos]", DenseGraphImpl, SparseGraphImpl, CSRGraphImpl) {
     int n_vertices = 12;
     std::vector<edge_t> edges = {
         {0, 1, 4}, {0, 7, 8}, {1, 2, 8},  {1, 7, 11}, {2, 3, 7},   {2, 5, 4},
@@ -211,16 +320,18 @@ TEMPLATE_TEST_CASE("Impl - Dijkstra/BellMan-Ford", "[impl-algos]", DenseGraphImp
     };
     const std::set<vertex_t> unreachable{9, 10, 11};
 
-    for (auto use_dijkstra_algo: {true, false}) {
+    for (auto algo : {"dijkstra", "BF", "SPFA"}) {
         for (auto directed : {true, false}) {
-            if (!use_dijkstra_algo && !directed) {
+            if (algo != std::string_view("dijkstra") && !directed) {
                 // Bellman-Ford only works with directed graphs
                 continue;
             }
-            CAPTURE(directed);
+            CAPTURE(algo, directed);
             TestType g(n_vertices, n_vertices, directed);
             g.set_edges(edges);
-            auto paths = use_dijkstra_algo ? g::all_shortest_paths(g, (vertex_t)0) : g::all_shortest_paths_BF(g, (vertex_t)0);
+            auto paths = algo == std::string_view("dijkstra") ? g::all_shortest_paths(g, (vertex_t)0)
+                         : algo == std::string_view("BF")     ? g::all_shortest_paths_BF(g, (vertex_t)0)
+                                                              : g::all_shortest_paths_SPFA(g, (vertex_t)0);
 
             CHECK(paths._distances == expected_distances[directed]);
             CHECK(paths._predecessors == expected_predecessors[directed]);
@@ -237,7 +348,536 @@ TEMPLATE_TEST_CASE("Impl - Dijkstra/BellMan-Ford", "[impl-algos]", DenseGraphImp
     }
 }
 
-TEMPLATE_TEST_CASE("Impl - A*", "[impl-algos]", DenseGraphImpl, SparseGraphImpl) {
+TEMPLATE_TEST_CASE("Impl - Bellman-Ford negative weights", "[impl-algos]", DenseGraphImpl, SparseGraphImpl, CSRGraphImpl) {
+    // a long chain with a few negative edges and shortcuts, the distances converge in a few rounds
+    constexpr vertex_t n = 200;
+    std::vector<edge_t> edges;
+    for (vertex_t i = 0; i + 1 < n; ++i) {
+        edges.push_back({i, i + 1, (i % 7 == 3) ? -2 : 3});
+        edges.push_back({i, (i * 11 + 5) % n, 40});
+    }
+    TestType g(n, n, true);
+    g.set_edges(edges);
+    for (vertex_t start : {0u, 57u, 199u}) {
+        CAPTURE(start);
+        auto bf = g::all_shortest_paths_BF(g, start);
+        auto spfa = g::all_shortest_paths_SPFA(g, start);
+        CHECK(bf._distances == spfa._distances);
+        for (vertex_t v = 0; v < n; ++v) {
+            CAPTURE(v);
+            CHECK(bf.is_reachable(v) == spfa.is_reachable(v));
+            if (v != start && spfa.is_reachable(v)) {
+                // the predecessors may differ between equal paths, but they must give the same distance
+                auto p = spfa._predecessors[v];
+                CHECK(g.weight(p, v) == spfa._distances[v] - spfa._distances[p]);
+            }
+        }
+    }
+
+    SECTION("negative cycle") {
+        // a chain with the cycle n -> n + 1 -> n + 2 -> n of weight -1 hanging from the vertex 100
+        std::vector<edge_t> cycle_edges{{n, n + 1, 1}, {n + 1, n + 2, 1}, {n + 2, n, -3}, {100, n, 1}};
+        for (vertex_t i = 0; i + 1 < n; ++i) {
+            cycle_edges.push_back({i, i + 1, 3});
+        }
+        TestType g_cycle(n + 3, n + 3, true);
+        g_cycle.set_edges(cycle_edges);
+        CHECK_THROWS_AS(g::all_shortest_paths_BF(g_cycle, 0), std::runtime_error);
+        CHECK_THROWS_AS(g::all_shortest_paths_SPFA(g_cycle, 0), std::runtime_error);
+        // the cycle isn't reachable from the vertex 101
+        auto bf = g::all_shortest_paths_BF(g_cycle, 101);
+        auto spfa = g::all_shortest_paths_SPFA(g_cycle, 101);
+        CHECK(bf._distances == spfa._distances);
+        CHECK(spfa._distances[n - 1] == 3 * (n - 102));
+
+        // a negative self loop is also a negative cycle
+        g_cycle.set_edge(150, 150, -1);
+        CHECK_THROWS_AS(g::all_shortest_paths_BF(g_cycle, 101), std::runtime_error);
+        CHECK_THROWS_AS(g::all_shortest_paths_SPFA(g_cycle, 101), std::runtime_error);
+    }
+}
+
+TEMPLATE_TEST_CASE("Impl - Negative cycles", "[impl-algos]", DenseGraphImpl, SparseGraphImpl, CSRGraphImpl) {
+    using cycle_t = std::vector<vertex_t>;
+    auto cycle_weight = [](const TestType& g, const cycle_t& cycle) {
+        weight_t w = 0;
+        for (std::size_t i = 0; i + 1 < cycle.size(); ++i) {
+            REQUIRE(g.has_edge(cycle[i], cycle[i + 1]));
+            w += g.weight(cycle[i], cycle[i + 1]);
+        }
+        return w;
+    };
+
+    SECTION("small graph") {
+        std::vector<edge_t> edges = {
+            // 1 -> 2 -> 3 -> 1 and 3 -> 4 -> 3 share the vertex 3
+            {0, 1, 5}, {1, 2, 1}, {2, 3, 1}, {3, 1, -3}, {3, 4, -2}, {4, 3, 1},
+            // a positive cycle
+            {0, 5, 1}, {5, 6, 2}, {6, 5, 1},
+            // a cycle which can't be reached from 0
+            {7, 8, -1}, {8, 9, -1}, {9, 7, 1},
+        };
+        TestType g(10, 10, true);
+        g.set_edges(edges);
+        auto cycles = g::find_negative_cycles(g);
+        std::set<cycle_t> found(cycles.begin(), cycles.end());
+        CHECK(found.size() == cycles.size());
+        CHECK(found == std::set<cycle_t>{{1, 2, 3, 1}, {3, 4, 3}, {7, 8, 9, 7}});
+
+        // without the negative edges
+        for (const auto& edge : edges) {
+            if (edge.weight < 0) {
+                g.set_edge(edge.start, edge.end, 1);
+            }
+        }
+        CHECK(g::find_negative_cycles(g).empty());
+        g.set_edge(6, 6, -1);
+        CHECK(g::find_negative_cycles(g) == std::vector<cycle_t>{{6, 6}});
+    }
+
+    SECTION("random graph") {
+        constexpr vertex_t n = 60;
+        auto edges = make_random_edges(n, 4 * n, n, [](vertex_t i, vertex_t, vertex_t) { return static_cast<weight_t>((i * 31) % 20) - 6; });
+        TestType g(n, n, true);
+        g.set_edges(edges);
+        auto cycles = g::find_negative_cycles(g);
+        CHECK(!cycles.empty());
+        std::set<cycle_t> found(cycles.begin(), cycles.end());
+        CHECK(found.size() == cycles.size());
+        for (const auto& cycle : cycles) {
+            CAPTURE(cycle);
+            CHECK(cycle.front() == cycle.back());
+            CHECK(cycle.front() == std::ranges::min(cycle));
+            CHECK(std::set<vertex_t>(cycle.begin(), cycle.end()).size() == cycle.size() - 1);
+            CHECK(cycle_weight(g, cycle) < 0);
+        }
+        // all the negative cycles go through the edges of the returned cycles
+        for (const auto& cycle : cycles) {
+            for (std::size_t i = 0; i + 1 < cycle.size(); ++i) {
+                g.set_edge(cycle[i], cycle[i + 1], 0);
+            }
+        }
+        CHECK(g::find_negative_cycles(g).empty());
+    }
+}
+
+TEMPLATE_TEST_CASE("Impl - Negative cycle monitor", "[impl-algos]", DenseGraphImpl, SparseGraphImpl) {
+    using cycle_t = std::vector<vertex_t>;
+    auto get_cycles = [](const auto& monitor) {
+        std::set<cycle_t> cycles;
+        for (auto cycle : monitor.get_cycles()) {
+            cycles.insert(std::move(cycle));
+        }
+        return cycles;
+    };
+
+    SECTION("small graph") {
+        TestType g(6, 6, true);
+        g.set_edges(std::vector<edge_t>{{0, 1, 1}, {1, 2, 1}, {2, 0, 1}, {2, 3, 2}, {3, 4, 2}, {4, 2, 2}, {4, 5, 1}});
+        g::NegativeCycleMonitor monitor(g);
+        CHECK(monitor.n_cycles() == 0);
+
+        monitor.set_edge(2, 0, -3);
+        auto changes = monitor.update();
+        CHECK(changes.formed == std::vector<cycle_t>{{0, 1, 2, 0}});
+        CHECK(changes.dissolved.empty());
+
+        // a batch which dissolves a cycle and forms two others
+        monitor.set_edge(2, 0, 1);
+        monitor.set_edge(4, 2, -5);
+        monitor.set_edge(5, 5, -1);
+        changes = monitor.update();
+        CHECK(changes.dissolved == std::vector<cycle_t>{{0, 1, 2, 0}});
+        CHECK(std::set<cycle_t>(changes.formed.begin(), changes.formed.end()) == std::set<cycle_t>{{2, 3, 4, 2}, {5, 5}});
+        CHECK(get_cycles(monitor) == std::set<cycle_t>{{2, 3, 4, 2}, {5, 5}});
+
+        // removing an edge dissolves a cycle
+        monitor.set_edge(3, 4, 0);
+        monitor.set_edge(5, 5, 1);
+        changes = monitor.update();
+        CHECK(changes.formed.empty());
+        CHECK(changes.dissolved.size() == 2);
+        CHECK(monitor.n_cycles() == 0);
+        CHECK(monitor.update().formed.empty());
+    }
+
+    SECTION("random updates") {
+        // a stream of updates on a complete graph, checked against the invariants
+        constexpr vertex_t n = 30;
+        TestType g(n, n, true);
+        for (vertex_t u = 0; u < n; ++u) {
+            for (vertex_t v = 0; v < n; ++v) {
+                if (u != v) {
+                    g.set_edge(u, v, static_cast<weight_t>(5 + (u * 7 + v * 3) % 11));
+                }
+            }
+        }
+        g::NegativeCycleMonitor monitor(g);
+        auto cycles = get_cycles(monitor);
+        CHECK(cycles.empty());
+        unsigned seed = 17;
+        auto random = [&seed](unsigned max) {
+            seed = seed * 1103515245u + 12345u;
+            return (seed >> 8) % max;
+        };
+        for (int batch = 0; batch < 200; ++batch) {
+            CAPTURE(batch);
+            for (auto k = random(4); k <= 3; ++k) {
+                auto u = random(n);
+                auto v = random(n);
+                auto w = static_cast<weight_t>(random(30)) - 12;
+                monitor.set_edge(u, v, u == v && w < 0 && random(3) != 0 ? 0 : w);
+            }
+            auto changes = monitor.update();
+            for (const auto& cycle : changes.dissolved) {
+                CHECK(cycles.erase(cycle) == 1);
+            }
+            for (const auto& cycle : changes.formed) {
+                CHECK(cycles.insert(cycle).second);
+            }
+            REQUIRE(cycles == get_cycles(monitor));
+
+            // the cycles are negative and there is no negative cycle left without their edges
+            auto others = monitor.graph();
+            for (const auto& cycle : cycles) {
+                CAPTURE(cycle);
+                CHECK(cycle.front() == std::ranges::min(cycle));
+                weight_t w = 0;
+                for (std::size_t i = 0; i + 1 < cycle.size(); ++i) {
+                    w += monitor.graph().weight(cycle[i], cycle[i + 1]);
+                    others.set_edge(cycle[i], cycle[i + 1], 0);
+                }
+                CHECK(w < 0);
+            }
+            REQUIRE(g::find_negative_cycles(others).empty());
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE(
+    "Impl - Dijkstra integral and floating point weights",
+    "[impl-algos]",
+    g::SparseGraphImpl<int>,
+    g::SparseGraphImpl<unsigned>,
+    g::SparseGraphImpl<long long>,
+    g::CSRGraphImpl<double>
+) {
+    using weight_lt = typename TestType::weight_lt;
+    using edge_lt = typename TestType::edge_lt;
+    // the integral weights use a radix heap, the floating point ones a d-ary heap
+    // they must give the same result as the Bellman-Ford algorithm
+    constexpr unsigned n = 300;
+    auto edges = make_test_edges<edge_lt>(n, 1);
+    TestType g(n, n, true);
+    g.set_edges(edges);
+    for (vertex_t start : {0u, 42u, 299u}) {
+        CAPTURE(start);
+        auto paths = g::all_shortest_paths(g, start);
+        auto expected = g::all_shortest_paths_BF(g, start);
+        CHECK(paths._distances == expected._distances);
+    }
+}
+
+TEMPLATE_TEST_CASE("Impl - Dijkstra batch", "[impl-algos]", DenseGraphImpl, SparseGraphImpl, CSRGraphImpl) {
+    // a sparse graph, with an unreachable vertex
+    constexpr vertex_t n = 300;
+    auto edges = make_test_edges(n, 0, 5);
+    TestType g(n, n, true);
+    g.set_edges(edges);
+
+    // the workspaces are reused: the sources are shuffled and repeated
+    std::vector<vertex_t> sources;
+    for (vertex_t i = 0; i < 2 * n; ++i) {
+        sources.push_back((i * 101) % n);
+    }
+    for (unsigned n_threads : {1u, 3u}) {
+        CAPTURE(n_threads);
+        std::mutex mutex;
+        std::vector<int> n_calls(n, 0);
+        g::all_shortest_paths(
+            g,
+            sources,
+            [&](vertex_t start, const g::AllShortestPathsImpl<int>& paths) {
+                auto expected = g::all_shortest_paths_SPFA(g, start);
+                std::lock_guard lock(mutex);
+                ++n_calls[start];
+                CHECK(paths._start == start);
+                CHECK(paths._distances == expected._distances);
+                for (vertex_t end = 0; end < n; end += 17) {
+                    auto path = paths.get_path(end);
+                    CHECK(path.empty() == !expected.is_reachable(end));
+                    if (!path.empty()) {
+                        CHECK(std::get<1>(path.back()) == expected._distances[end]);
+                    }
+                }
+            },
+            n_threads
+        );
+        CHECK(std::ranges::all_of(n_calls, [](int count) { return count == 2; }));
+    }
+
+    SECTION("exception in the sink") {
+        auto throwing = [](vertex_t start, const auto&) {
+            if (start == 42) {
+                throw std::invalid_argument("42");
+            }
+        };
+        CHECK_THROWS_AS(g::all_shortest_paths(g, sources, throwing, 3), std::invalid_argument);
+        CHECK_NOTHROW(g::all_shortest_paths(g, std::vector<vertex_t>{}, throwing));
+    }
+}
+
+TEMPLATE_TEST_CASE("Impl - Dijkstra with bounds", "[impl-algos]", DenseGraphImpl, SparseGraphImpl, CSRGraphImpl) {
+    constexpr vertex_t n = 300;
+    auto edges = make_test_edges(n, 1);
+    TestType g(n, n, true);
+    g.set_edges(edges);
+    const vertex_t start = 42;
+    const auto expected = g::all_shortest_paths(g, start);
+
+    // the vertices found are settled by increasing distance, with their paths
+    auto check_found = [&](const g::BoundedShortestPathsImpl<int>& paths) {
+        int last = 0;
+        for (auto v : paths.vertices()) {
+            CAPTURE(v);
+            CHECK(paths.get_distance(v) == expected._distances[v]);
+            CHECK(paths.get_distance(v) >= last);
+            last = paths.get_distance(v);
+            auto path = paths.get_path(v);
+            REQUIRE(!path.empty());
+            CHECK(std::get<0>(path.front()) == start);
+            CHECK(std::get<0>(path.back()) == v);
+            CHECK(std::get<1>(path.back()) == expected._distances[v]);
+        }
+        CHECK(paths.size() == paths.vertices().size());
+    };
+
+    SECTION("no bounds") {
+        auto paths = g::all_shortest_paths(g, start, {});
+        check_found(paths);
+        CHECK(paths.size() == n);
+    }
+
+    SECTION("max distance") {
+        for (int max_distance : {0, 10, 40, 100}) {
+            CAPTURE(max_distance);
+            auto paths = g::all_shortest_paths(g, start, {.max_distance = max_distance});
+            check_found(paths);
+            for (vertex_t v = 0; v < n; ++v) {
+                CHECK(paths.is_reachable(v) == (expected._distances[v] <= max_distance));
+            }
+            CHECK(paths.get_distance(paths.vertices().back()) <= max_distance);
+        }
+    }
+
+    SECTION("targets") {
+        std::vector<vertex_t> targets = {43, 7, 250};
+        auto paths = g::all_shortest_paths(g, start, {.targets = targets});
+        check_found(paths);
+        auto farthest = std::ranges::max(targets, {}, [&](vertex_t v) { return expected._distances[v]; });
+        CHECK(paths.get_distance(paths.vertices().back()) == expected._distances[farthest]);
+        CHECK(std::ranges::all_of(targets, [&](vertex_t v) { return paths.is_reachable(v); }));
+        CHECK(paths.size() < n);
+        for (vertex_t v = 0; v < n; ++v) {
+            if (expected._distances[v] < expected._distances[farthest]) {
+                CHECK(paths.is_reachable(v));
+            }
+        }
+        // the start is settled first
+        CHECK(g::all_shortest_paths(g, start, {.targets = {start, start}}).size() == 1);
+    }
+
+    SECTION("max hops") {
+        // the shortest paths with the fewest edges, from a breadth first search on the tight edges
+        std::vector<std::size_t> hops(n, g::ShortestPathsBounds<int>::NO_MAX_HOPS);
+        std::vector<vertex_t> queue = {start};
+        hops[start] = 0;
+        for (std::size_t i = 0; i < queue.size(); ++i) {
+            auto u = queue[i];
+            g::for_each_neighbor(g, u, [&](const auto& edge) {
+                if (expected._distances[u] + edge.weight == expected._distances[edge.end] &&
+                    hops[edge.end] == g::ShortestPathsBounds<int>::NO_MAX_HOPS) {
+                    hops[edge.end] = hops[u] + 1;
+                    queue.push_back(edge.end);
+                }
+            });
+        }
+        for (std::size_t max_hops : {0u, 1u, 3u, 6u}) {
+            CAPTURE(max_hops);
+            auto paths = g::all_shortest_paths(g, start, {.max_hops = max_hops});
+            check_found(paths);
+            for (vertex_t v = 0; v < n; ++v) {
+                CAPTURE(v);
+                CHECK(paths.is_reachable(v) == (hops[v] <= max_hops));
+                if (paths.is_reachable(v)) {
+                    CHECK(paths.get_path(v).size() == hops[v] + 1);
+                }
+            }
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE(
+    "Impl - Floyd-Warshall",
+    "[impl-algos]",
+    DenseGraphImpl,
+    SparseGraphImpl,
+    g::DenseGraphImpl<double>,
+    g::DenseGraphImpl<long long>
+) {
+    using weight_lt = typename TestType::weight_lt;
+    using edge_lt = typename TestType::edge_lt;
+    // several tiles, with negative weights but without negative cycles: w(u, v) = w'(u, v) + p(u) - p(v)
+    constexpr vertex_t n = 150;
+    auto potential = [](vertex_t v) { return static_cast<weight_lt>((v * 37) % 50); };
+    auto edges = make_random_edges<edge_lt>(n, 4 * n, n, [&](vertex_t i, vertex_t u, vertex_t v) {
+        return static_cast<weight_lt>(1 + (i * 31) % 40) + potential(u) - potential(v);
+    });
+    TestType g(n, n, true);
+    g.set_edges(edges);
+
+    for (bool with_next_hops : {false, true}) {
+        for (unsigned n_threads : {1u, 3u}) {
+            CAPTURE(with_next_hops, n_threads);
+            auto apsp = g::all_pairs_shortest_paths_FW(g, with_next_hops, n_threads);
+            REQUIRE(apsp.size() == n);
+            CHECK(apsp.has_next_hops() == with_next_hops);
+            for (vertex_t start = 0; start < n; start += 7) {
+                CAPTURE(start);
+                auto expected = g::all_shortest_paths_SPFA(g, start);
+                CHECK(std::ranges::equal(apsp.get_row(start), expected._distances));
+                if (!with_next_hops) {
+                    CHECK_THROWS_AS(apsp.get_path(start, 0), g::error);
+                    continue;
+                }
+                for (vertex_t end = 0; end < n; ++end) {
+                    auto path = apsp.get_path(start, end);
+                    if (!apsp.is_reachable(start, end)) {
+                        CHECK(path.empty());
+                        continue;
+                    }
+                    REQUIRE(!path.empty());
+                    CHECK(std::get<0>(path.front()) == start);
+                    CHECK(std::get<0>(path.back()) == end);
+                    CHECK(std::get<1>(path.back()) == apsp.get_distance(start, end));
+                    weight_lt w = 0;
+                    for (std::size_t i = 0; i + 1 < path.size(); ++i) {
+                        w += g.weight(std::get<0>(path[i]), std::get<0>(path[i + 1]));
+                    }
+                    CHECK(w == apsp.get_distance(start, end));
+                }
+            }
+        }
+    }
+
+    SECTION("undirected graph") {
+        TestType u(n, n, false);
+        for (const auto& edge : edges) {
+            u.set_edge(edge.start, edge.end, static_cast<weight_lt>(1 + (edge.start + edge.end) % 9));
+        }
+        auto apsp = g::all_pairs_shortest_paths_FW(u);
+        for (vertex_t start = 0; start < n; start += 11) {
+            CHECK(std::ranges::equal(apsp.get_row(start), g::all_shortest_paths(u, start)._distances));
+        }
+    }
+
+    SECTION("negative cycle") {
+        g.set_edge(140, 2, -1000);
+        g.set_edge(2, 140, 1);
+        CHECK_THROWS_AS(g::all_pairs_shortest_paths_FW(g), std::runtime_error);
+    }
+}
+
+TEMPLATE_TEST_CASE(
+    "Impl - Johnson",
+    "[impl-algos]",
+    DenseGraphImpl,
+    SparseGraphImpl,
+    CSRGraphImpl,
+    g::DenseGraphImpl<double>
+) {
+    using weight_lt = typename TestType::weight_lt;
+    using edge_lt = typename TestType::edge_lt;
+    // a sparse graph with negative weights but without negative cycles: w(u, v) = w'(u, v) + p(u) - p(v)
+    constexpr vertex_t n = 200;
+    auto potential = [](vertex_t v) { return static_cast<weight_lt>((v * 37) % 50); };
+    auto edges = make_random_edges<edge_lt>(n, 3 * n, n, [&](vertex_t i, vertex_t u, vertex_t v) {
+        return static_cast<weight_lt>((i * 31) % 40) + potential(u) - potential(v);
+    });
+    TestType g(n, n, true);
+    g.set_edges(edges);
+    auto expected = g::all_pairs_shortest_paths_FW(g);
+
+    for (bool with_next_hops : {false, true}) {
+        for (unsigned n_threads : {1u, 3u}) {
+            CAPTURE(with_next_hops, n_threads);
+            auto apsp = g::all_pairs_shortest_paths_johnson(g, with_next_hops, n_threads);
+            REQUIRE(apsp.size() == n);
+            CHECK(apsp.has_next_hops() == with_next_hops);
+            for (vertex_t start = 0; start < n; ++start) {
+                CAPTURE(start);
+                CHECK(std::ranges::equal(apsp.get_row(start), expected.get_row(start)));
+            }
+            if (!with_next_hops) {
+                continue;
+            }
+            for (vertex_t start = 0; start < n; start += 13) {
+                for (vertex_t end = 0; end < n; ++end) {
+                    CAPTURE(start, end);
+                    auto path = apsp.get_path(start, end);
+                    if (!apsp.is_reachable(start, end)) {
+                        CHECK(path.empty());
+                        continue;
+                    }
+                    REQUIRE(!path.empty());
+                    CHECK(std::get<0>(path.back()) == end);
+                    weight_lt w = 0;
+                    for (std::size_t i = 0; i + 1 < path.size(); ++i) {
+                        w += g.weight(std::get<0>(path[i]), std::get<0>(path[i + 1]));
+                    }
+                    CHECK(w == apsp.get_distance(start, end));
+                }
+            }
+        }
+    }
+
+    SECTION("callback") {
+        std::mutex mutex;
+        std::vector<bool> is_done(n, false);
+        g::all_pairs_shortest_paths_johnson(
+            g,
+            [&](vertex_t start, const g::AllShortestPathsImpl<weight_lt>& paths) {
+                std::lock_guard lock(mutex);
+                CHECK(!is_done[start]);
+                is_done[start] = true;
+                CHECK(std::ranges::equal(paths._distances, expected.get_row(start)));
+                auto path = paths.get_path((start + 1) % n);
+                if (!path.empty()) {
+                    CHECK(std::get<1>(path.back()) == expected.get_distance(start, (start + 1) % n));
+                }
+            },
+            3
+        );
+        CHECK(std::ranges::all_of(is_done, std::identity()));
+
+        auto throwing = [](vertex_t start, const auto&) {
+            if (start == 42) {
+                throw std::invalid_argument("42");
+            }
+        };
+        CHECK_THROWS_AS(g::all_pairs_shortest_paths_johnson(g, throwing, 3), std::invalid_argument);
+    }
+
+    SECTION("negative cycle") {
+        TestType h(n, n, true);
+        edges.push_back({140, 2, -1000});
+        edges.push_back({2, 140, 1});
+        h.set_edges(edges);
+        CHECK_THROWS_AS(g::all_pairs_shortest_paths_johnson(h), std::runtime_error);
+    }
+}
+
+TEMPLATE_TEST_CASE("Impl - A*", "[impl-algos]", DenseGraphImpl, SparseGraphImpl, CSRGraphImpl) {
     int n_vertices = 12;
     std::vector<edge_t> edges = {
         {0, 1, 4}, {0, 7, 8}, {1, 2, 8},  {1, 7, 11}, {2, 3, 7},   {2, 5, 4},
@@ -272,8 +912,9 @@ TEMPLATE_TEST_CASE("Impl - A*", "[impl-algos]", DenseGraphImpl, SparseGraphImpl)
         g.set_edges(edges);
         for (auto [start, end, expected_path] : expected[directed]) {
             CAPTURE(start, end, directed);
-            // build our cost function from the real distances
-            auto paths_to_end = g::all_shortest_paths(g, end);
+            // build our cost function from the real distances to end (i.e. from end in the inverted graph)
+            auto inverted = g.invert();
+            auto paths_to_end = g::all_shortest_paths(inverted, end);
             auto cost_function = [&paths_to_end](vertex_t i, vertex_t /* j */) {
                 return paths_to_end._distances[i];
             };
@@ -283,7 +924,206 @@ TEMPLATE_TEST_CASE("Impl - A*", "[impl-algos]", DenseGraphImpl, SparseGraphImpl)
     }
 }
 
-TEMPLATE_TEST_CASE("Impl - Max Flow", "[impl-algos]", DenseGraphImpl, SparseGraphImpl) {
+TEMPLATE_TEST_CASE("Impl - Bidirectional shortest path", "[impl-algos]", DenseGraphImpl, SparseGraphImpl, CSRGraphImpl) {
+    int n_vertices = 12;
+    std::vector<edge_t> edges = {
+        {0, 1, 4}, {0, 7, 8}, {1, 2, 8},  {1, 7, 11}, {2, 3, 7},   {2, 5, 4},
+        {2, 8, 2}, {3, 4, 9}, {3, 5, 14}, {4, 5, 10}, {5, 6, 2},   {6, 7, 1},
+        {6, 8, 6}, {7, 8, 7}, {9, 10, 4}, {9, 11, 2}, {11, 10, 1},
+    };
+
+    std::vector<std::tuple<vertex_t, vertex_t, std::vector<step_t>>> expected[2] = {
+        {
+            {0, 8, {{0, 0}, {1, 4}, {2, 12}, {8, 14}}},
+            {0, 5, {{0, 0}, {7, 8}, {6, 9}, {5, 11}}},
+            {4, 2, {{4, 0}, {5, 10}, {2, 14}}},
+            {3, 3, {{3, 0}}},
+            {0, 11, {}},
+        },
+        {
+            {0, 8, {{0, 0}, {1, 4}, {2, 12}, {8, 14}}},
+            {0, 5, {{0, 0}, {1, 4}, {2, 12}, {5, 16}}},
+            {3, 3, {{3, 0}}},
+            {4, 2, {}},
+            {0, 11, {}},
+        },
+    };
+
+    for (auto directed : {true, false}) {
+        TestType g(n_vertices, n_vertices, directed);
+        g.set_edges(edges);
+        auto inverted = g.invert();
+        for (auto [start, end, expected_path] : expected[directed]) {
+            CAPTURE(start, end, directed);
+            CHECK(g::bidirectional_shortest_path(g, start, end).get_path() == expected_path);
+            CHECK(g::bidirectional_shortest_path(g, inverted, start, end).get_path() == expected_path);
+
+            // the real distances from start and to end are consistent estimations
+            auto paths_from_start = g::all_shortest_paths(g, start);
+            auto paths_to_end = g::all_shortest_paths(inverted, end);
+            auto cost_function = [&](vertex_t i, vertex_t j) {
+                return j == end ? paths_to_end._distances[i] : paths_from_start._distances[j];
+            };
+            CHECK(g::bidirectional_shortest_path(g, start, end, cost_function).get_path() == expected_path);
+            CHECK(g::bidirectional_shortest_path(g, inverted, start, end, cost_function).get_path() == expected_path);
+        }
+    }
+
+    SECTION("Larger graph") {
+        constexpr unsigned n = 300;
+        auto large_edges = make_test_edges(n);
+        for (auto directed : {true, false}) {
+            TestType g(n, n, directed);
+            g.set_edges(large_edges);
+            auto inverted = g.invert();
+            for (vertex_t start = 0; start < n; start += 37) {
+                auto expected = g::all_shortest_paths(g, start);
+                auto zero_cost = [](vertex_t, vertex_t) { return 0; };
+                for (vertex_t end = 0; end < n; end += 11) {
+                    CAPTURE(directed, start, end);
+                    auto results = {
+                        g::bidirectional_shortest_path(g, start, end),
+                        g::bidirectional_shortest_path(g, inverted, start, end),
+                        g::bidirectional_shortest_path(g, start, end, zero_cost),
+                    };
+                    for (const auto& result : results) {
+                        REQUIRE(result.is_reachable() == expected.is_reachable(end));
+                        auto path = result.get_path();
+                        if (path.empty()) {
+                            continue;
+                        }
+                        CHECK(std::get<1>(path.back()) == expected._distances[end]);
+                        // the path is made of edges of the graph
+                        for (std::size_t i = 1; i < path.size(); ++i) {
+                            auto [u, d_u] = path[i - 1];
+                            auto [v, d_v] = path[i];
+                            CHECK(d_u + g.weight(u, v) == d_v);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE("Impl - Contraction hierarchy", "[impl-algos]", DenseGraphImpl, SparseGraphImpl, CSRGraphImpl) {
+    constexpr unsigned n = 200;
+    // with an unreachable vertex
+    auto edges = make_test_edges(n, 4, 5);
+
+    for (auto directed : {true, false}) {
+        TestType g(n, n, directed);
+        g.set_edges(edges);
+        auto hierarchy = g::contraction_hierarchy(g);
+        CHECK(hierarchy.size() == n);
+        // the ranks are a permutation of the vertices
+        auto ranks = hierarchy._ranks;
+        std::ranges::sort(ranks);
+        CHECK(std::ranges::equal(ranks, std::views::iota(vertex_t{0}, vertex_t{n})));
+
+        g::ContractionHierarchyQuery query(hierarchy);
+        for (vertex_t start = 0; start < n; start += 7) {
+            auto expected = g::all_shortest_paths(g, start);
+            for (vertex_t end = 0; end < n; ++end) {
+                CAPTURE(directed, start, end);
+                REQUIRE(query.distance(start, end) == expected._distances[end]);
+                auto path = query.get_path(start, end);
+                if (!expected.is_reachable(end)) {
+                    CHECK(path.empty());
+                    continue;
+                }
+                // the shortcuts are unpacked into the edges of the graph
+                REQUIRE(path.front() == step_t{start, 0});
+                REQUIRE(std::get<0>(path.back()) == end);
+                for (std::size_t i = 1; i < path.size(); ++i) {
+                    auto [u, d_u] = path[i - 1];
+                    auto [v, d_v] = path[i];
+                    CHECK(d_u + g.weight(u, v) == d_v);
+                }
+                CHECK(std::get<1>(path.back()) == expected._distances[end]);
+            }
+            CHECK(query.shortest_path(start, (start + 100) % n).get_path() == query.get_path(start, (start + 100) % n));
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE("Impl - Landmarks", "[impl-algos]", DenseGraphImpl, SparseGraphImpl, CSRGraphImpl) {
+    constexpr unsigned n = 300;
+    // with an unreachable vertex
+    auto edges = make_test_edges(n, 0, 5);
+
+    for (auto directed : {true, false}) {
+        TestType g(n, n, directed);
+        g.set_edges(edges);
+        for (auto selection : {g::LandmarkSelection::Farthest, g::LandmarkSelection::Avoid}) {
+            for (unsigned n_landmarks : {1u, 4u}) {
+                CAPTURE(directed, selection, n_landmarks);
+                auto heuristic = g::landmark_heuristic(g, n_landmarks, selection);
+                auto landmarks = heuristic.get_landmarks();
+                CHECK(landmarks.size() == n_landmarks);
+                std::ranges::sort(landmarks);
+                CHECK(std::ranges::adjacent_find(landmarks) == landmarks.end());
+                CHECK(heuristic.memory_size() == n * n_landmarks * sizeof(weight_t) * (directed ? 2 : 1));
+
+                for (vertex_t start = 0; start < n; start += 23) {
+                    auto expected = g::all_shortest_paths(g, start);
+                    for (vertex_t v = 0; v < n; ++v) {
+                        // the estimation never overestimates the distance
+                        auto h = heuristic(start, v);
+                        CHECK((h == D_INFINITY || h <= expected._distances[v]));
+                        if (expected.is_reachable(v)) {
+                            CHECK(h != D_INFINITY);
+                        }
+                    }
+                    for (vertex_t end = 1; end < n; end += 37) {
+                        auto path = g::shortest_path(g, start, end, heuristic);
+                        REQUIRE(path.is_reachable() == expected.is_reachable(end));
+                        if (path.is_reachable()) {
+                            CHECK(std::get<1>(path.get_path().back()) == expected._distances[end]);
+                        }
+                    }
+                }
+                // the estimation is consistent
+                for (const auto& edge : g.get_all_edges()) {
+                    for (vertex_t end = 0; end < n; end += 29) {
+                        auto h_start = heuristic(edge.start, end);
+                        auto h_end = heuristic(edge.end, end);
+                        if (h_end != D_INFINITY) {
+                            CHECK(h_start <= edge.weight + h_end);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // a single vertex, and as many landmarks as vertices: the selection stops when no vertex is left
+    TestType single(1, 1, true);
+    TestType small(5, 5, false);
+    small.set_edges(std::vector<edge_t>{{0, 1, 2}, {1, 2, 1}, {2, 3, 4}, {3, 4, 1}});
+    for (auto selection : {g::LandmarkSelection::Farthest, g::LandmarkSelection::Avoid}) {
+        CAPTURE(selection);
+        for (unsigned n_landmarks : {1u, 3u}) {
+            auto heuristic = g::landmark_heuristic(single, n_landmarks, selection);
+            CHECK(heuristic.get_landmarks() == std::vector<vertex_t>{0});
+            CHECK(heuristic(0, 0) == 0);
+        }
+        auto heuristic = g::landmark_heuristic(small, small.size(), selection);
+        auto landmarks = heuristic.get_landmarks();
+        CHECK(!landmarks.empty());
+        CHECK(landmarks.size() <= small.size());
+        std::ranges::sort(landmarks);
+        CHECK(std::ranges::adjacent_find(landmarks) == landmarks.end());
+        for (vertex_t start = 0; start < small.size(); ++start) {
+            auto expected = g::all_shortest_paths(small, start);
+            for (vertex_t v = 0; v < small.size(); ++v) {
+                CHECK(heuristic(start, v) <= expected._distances[v]);
+            }
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE("Impl - Max Flow", "[impl-algos]", DenseGraphImpl, SparseGraphImpl, CSRGraphImpl) {
     int n_vertices = 6;
     std::vector<edge_t> edges = {
         {0, 1, 16}, {0, 2, 13}, {1, 2, 10}, {1, 3, 12}, {2, 1, 4},
@@ -296,9 +1136,286 @@ TEMPLATE_TEST_CASE("Impl - Max Flow", "[impl-algos]", DenseGraphImpl, SparseGrap
     auto max_flow = g::maximum_flow(g, 0, 5);
     CAPTURE(max_flow);
     CHECK(max_flow == 23);
+
+    // the flows respect the capacities and are conserved, and their value is the capacity of a cut
+    auto check_flows = [](const TestType& graph, vertex_t source, vertex_t sink, const g::MaximumFlowImpl<TestType>& res) {
+        const auto n = graph.size();
+        std::vector<int> balances(n, 0);
+        for (const auto& edge : res.flows.get_all_edges()) {
+            CHECK(edge.weight > 0);
+            CHECK(edge.weight <= graph.weight(edge.start, edge.end));
+            balances[edge.start] -= edge.weight;
+            balances[edge.end] += edge.weight;
+        }
+        for (vertex_t v = 0; v < n; ++v) {
+            CAPTURE(v);
+            CHECK(balances[v] == (v == source ? -res.value : v == sink ? res.value : 0));
+        }
+        // the vertices reachable from the source in the residual network
+        std::vector<bool> is_reachable(n, false);
+        std::vector<vertex_t> stack = {source};
+        is_reachable[source] = true;
+        while (!stack.empty()) {
+            auto u = stack.back();
+            stack.pop_back();
+            for (vertex_t v = 0; v < n; ++v) {
+                auto residual = graph.weight(u, v) - res.flows.weight(u, v) + res.flows.weight(v, u);
+                if (residual > 0 && !is_reachable[v]) {
+                    is_reachable[v] = true;
+                    stack.push_back(v);
+                }
+            }
+        }
+        CHECK(!is_reachable[sink]);
+        int cut = 0;
+        for (const auto& edge : graph.get_all_edges()) {
+            if (is_reachable[edge.start] && !is_reachable[edge.end]) {
+                cut += edge.weight;
+            }
+        }
+        CHECK(cut == res.value);
+    };
+
+    for (bool dinic : {false, true}) {
+        CAPTURE(dinic);
+        auto res = dinic ? g::maximum_flow_dinic(g, 0, 5) : g::maximum_flow_push_relabel(g, 0, 5);
+        CHECK(res.value == 23);
+        check_flows(g, 0, 5, res);
+
+        // a larger network, with antiparallel edges and vertices which can't reach the sink
+        constexpr vertex_t n = 200;
+        auto random_edges = make_random_edges(n, 6 * n, n - 10, [](vertex_t i, vertex_t, vertex_t) { return static_cast<int>(1 + (i * 31) % 50); });
+        TestType r(n, n, true);
+        r.set_edges(random_edges);
+        for (auto [source, sink] : {std::pair<vertex_t, vertex_t>{3, 150}, {0, 1}, {150, 3}, {195, 7}}) {
+            CAPTURE(source, sink);
+            auto res = dinic ? g::maximum_flow_dinic(r, source, sink) : g::maximum_flow_push_relabel(r, source, sink);
+            CHECK(res.value > 0);
+            CHECK(res.value == g::maximum_flow(r, source, sink));
+            check_flows(r, source, sink, res);
+        }
+        // the sink can't be reached
+        CHECK(g::maximum_flow_dinic(r, 7, 195).value == 0);
+        CHECK(g::maximum_flow_push_relabel(r, 7, 195).value == 0);
+    }
+
+    CHECK_THROWS_AS(g::maximum_flow_dinic(g, 2, 2), g::error);
+    TestType u(n_vertices, n_vertices, false);
+    CHECK_THROWS_AS(g::maximum_flow_push_relabel(u, 0, 5), g::error);
+}
+
+TEMPLATE_TEST_CASE("Impl - Min Cost Flow", "[impl-algos]", DenseGraphImpl, SparseGraphImpl, CSRGraphImpl) {
+    // edges (start, end, capacity) and their costs
+    auto make_network = [](vertex_t n, const std::vector<std::pair<edge_t, int>>& edges) {
+        std::vector<edge_t> capacities;
+        std::vector<edge_t> costs;
+        for (const auto& [edge, cost] : edges) {
+            capacities.push_back(edge);
+            costs.push_back({edge.start, edge.end, cost});
+        }
+        std::pair<TestType, TestType> res {TestType(n, n, true), TestType(n, n, true)};
+        res.first.set_edges(capacities);
+        res.second.set_edges(costs);
+        return res;
+    };
+
+    // the flows respect the capacities and are conserved, their cost is the total cost, and the residual
+    // network has no cycle of negative cost (so no cheaper flow of the same value exists)
+    auto check_flows = [](const TestType& graph, const TestType& costs, vertex_t source, vertex_t sink,
+                          const g::MinimumCostFlowImpl<TestType, weight_t>& res) {
+        const auto n = graph.size();
+        std::vector<int> balances(n, 0);
+        int cost = 0;
+        for (const auto& edge : res.flows.get_all_edges()) {
+            CHECK(edge.weight <= graph.weight(edge.start, edge.end));
+            balances[edge.start] -= edge.weight;
+            balances[edge.end] += edge.weight;
+            cost += edge.weight * costs.weight(edge.start, edge.end);
+        }
+        for (vertex_t v = 0; v < n; ++v) {
+            CHECK(balances[v] == (v == source ? -res.value : v == sink ? res.value : 0));
+        }
+        CHECK(cost == res.cost);
+
+        std::vector<edge_t> residual_arcs;
+        for (const auto& edge : graph.get_all_edges()) {
+            auto flow = res.flows.weight(edge.start, edge.end);
+            auto edge_cost = costs.weight(edge.start, edge.end);
+            if (flow < edge.weight) {
+                residual_arcs.push_back({edge.start, edge.end, edge_cost});
+            }
+            if (flow > 0) {
+                residual_arcs.push_back({edge.end, edge.start, -edge_cost});
+            }
+        }
+        std::vector<int> distances(n, 0);
+        bool is_updated = true;
+        for (vertex_t i = 0; i <= n && is_updated; ++i) {
+            is_updated = false;
+            for (const auto& arc : residual_arcs) {
+                if (distances[arc.start] + arc.weight < distances[arc.end]) {
+                    distances[arc.end] = distances[arc.start] + arc.weight;
+                    is_updated = true;
+                }
+            }
+        }
+        CHECK(!is_updated);
+    };
+
+    auto [g, costs] = make_network(4, {
+        {{0, 1, 2}, 1}, {{0, 2, 2}, 2}, {{1, 3, 1}, 1}, {{1, 2, 2}, 0}, {{2, 3, 3}, 1},
+    });
+    auto res = g::minimum_cost_flow(g, costs, 0, 3);
+    CHECK(res.value == 4);
+    CHECK(res.cost == 10);
+    check_flows(g, costs, 0, 3, res);
+    // the two cheapest units go through 1
+    res = g::minimum_cost_flow(g, costs, 0, 3, 2);
+    CHECK(res.value == 2);
+    CHECK(res.cost == 4);
+    CHECK(res.flows.weight(0, 1) == 2);
+    check_flows(g, costs, 0, 3, res);
+
+    // the initial potentials are only computed (with the Bellman-Ford algorithm) for negative costs
+    auto has_negative_costs = [](const TestType& graph, const TestType& costs) {
+        g::internal::ResidualNetwork<weight_t> network(graph);
+        auto arc_costs = g::internal::get_arc_costs(network, [&](vertex_t u, vertex_t v) { return costs.weight(u, v); });
+        return g::internal::SuccessiveShortestPaths(network, arc_costs, 0, 3).has_negative_costs();
+    };
+    CHECK_FALSE(has_negative_costs(g, costs));
+
+    // negative costs
+    auto [n, n_costs] = make_network(4, {{{0, 1, 1}, -3}, {{1, 3, 1}, 1}, {{0, 3, 1}, 0}, {{0, 2, 1}, -5}});
+    CHECK(has_negative_costs(n, n_costs));
+    res = g::minimum_cost_flow(n, n_costs, 0, 3);
+    CHECK(res.value == 2);
+    CHECK(res.cost == -2);
+    check_flows(n, n_costs, 0, 3, res);
+
+    // a larger network, with antiparallel edges and vertices which can't reach the sink
+    constexpr vertex_t n_random = 100;
+    std::vector<std::pair<edge_t, int>> random_edges;
+    auto random_capacities = make_random_edges(n_random, 5 * n_random, n_random - 10, [](vertex_t i, vertex_t, vertex_t) {
+        return static_cast<int>(1 + (i * 31) % 20);
+    });
+    for (std::size_t i = 0; i < random_capacities.size(); ++i) {
+        random_edges.push_back({random_capacities[i], static_cast<int>(1 + (i * 17) % 9)});
+    }
+    auto [r, r_costs] = make_network(n_random, random_edges);
+    for (auto [source, sink] : {std::pair<vertex_t, vertex_t>{3, 50}, {0, 1}, {95, 7}}) {
+        CAPTURE(source, sink);
+        auto res = g::minimum_cost_flow(r, r_costs, source, sink);
+        CHECK(res.value == g::maximum_flow(r, source, sink));
+        check_flows(r, r_costs, source, sink, res);
+        auto half = g::minimum_cost_flow(r, r_costs, source, sink, res.value / 2);
+        CHECK(half.value == res.value / 2);
+        check_flows(r, r_costs, source, sink, half);
+    }
+
+    CHECK_THROWS_AS(g::minimum_cost_flow(g, costs, 2, 2), g::error);
+    auto [c, c_costs] = make_network(4, {{{0, 1, 1}, 1}, {{1, 2, 1}, -2}, {{2, 1, 1}, -2}, {{2, 3, 1}, 1}});
+    CHECK_THROWS_AS(g::minimum_cost_flow(c, c_costs, 0, 3), g::error);
+}
+
+TEMPLATE_TEST_CASE("Impl - Min Cut", "[impl-algos]", DenseGraphImpl, SparseGraphImpl, CSRGraphImpl) {
+    // the cut edges go from the side to the other vertices, and their weights sum up to the value
+    auto check_cut = [](const TestType& graph, const g::MinimumCutImpl<weight_t>& cut) {
+        std::vector<bool> is_in_side(graph.size(), false);
+        for (auto v : cut.vertices) {
+            is_in_side[v] = true;
+        }
+        int value = 0;
+        for (const auto& edge : cut.edges) {
+            CHECK(is_in_side[edge.start]);
+            CHECK(!is_in_side[edge.end]);
+            CHECK(edge.weight == graph.weight(edge.start, edge.end));
+            value += edge.weight;
+        }
+        CHECK(value == cut.value);
+        CHECK(!cut.vertices.empty());
+        CHECK(cut.vertices.size() < graph.size());
+    };
+
+    SECTION("s-t cut") {
+        int n_vertices = 6;
+        std::vector<edge_t> edges = {
+            {0, 1, 16}, {0, 2, 13}, {1, 2, 10}, {1, 3, 12}, {2, 1, 4},
+            {2, 4, 14}, {3, 2, 9},  {3, 5, 20}, {4, 3, 7},  {4, 5, 4},
+        };
+        TestType g(n_vertices, n_vertices, true);
+        g.set_edges(edges);
+
+        auto cut = g::minimum_cut(g, 0, 5);
+        CHECK(cut.value == 23);
+        check_cut(g, cut);
+        CHECK(std::ranges::find(cut.vertices, 0) != cut.vertices.end());
+        CHECK(std::ranges::find(cut.vertices, 5) == cut.vertices.end());
+        CHECK_THROWS_AS(g::minimum_cut(g, 3, 3), g::error);
+
+        constexpr vertex_t n = 200;
+        auto random_edges = make_random_edges(n, 6 * n, n - 10, [](vertex_t i, vertex_t, vertex_t) { return static_cast<int>(1 + (i * 31) % 50); });
+        TestType r(n, n, true);
+        r.set_edges(random_edges);
+        for (auto [source, sink] : {std::pair<vertex_t, vertex_t>{3, 150}, {0, 1}, {150, 3}, {7, 195}}) {
+            CAPTURE(source, sink);
+            auto res = g::minimum_cut(r, source, sink);
+            CHECK(res.value == g::maximum_flow(r, source, sink));
+            check_cut(r, res);
+            CHECK(std::ranges::find(res.vertices, source) != res.vertices.end());
+            CHECK(std::ranges::find(res.vertices, sink) == res.vertices.end());
+        }
+    }
+
+    SECTION("global cut") {
+        // two cliques joined by two light edges
+        int n_vertices = 10;
+        std::vector<edge_t> edges = {{0, 5, 1}, {1, 6, 1}};
+        for (vertex_t u = 0; u < 5; ++u) {
+            for (vertex_t v = u + 1; v < 5; ++v) {
+                edges.push_back({u, v, 3});
+                edges.push_back({u + 5, v + 5, 3});
+            }
+        }
+        TestType g(n_vertices, n_vertices, false);
+        g.set_edges(edges);
+        for (const auto& cut : {g::minimum_cut_stoer_wagner(g), g::minimum_cut_karger_stein(g, 10, 2)}) {
+            CHECK(cut.value == 2);
+            check_cut(g, cut);
+            CHECK(cut.vertices.size() == 5);
+        }
+
+        // a random graph: the global minimum cut is the smallest cut between the vertex 0 and another vertex
+        constexpr vertex_t n = 40;
+        auto random_edges = make_random_edges(n, 3 * n, n, [](vertex_t i, vertex_t, vertex_t) { return static_cast<int>(1 + (i * 31) % 10); });
+        TestType r(n, n, false);
+        r.set_edges(random_edges);
+        int expected = D_INFINITY;
+        for (vertex_t v = 1; v < n; ++v) {
+            expected = std::min(expected, g::minimum_cut(r, 0, v).value);
+        }
+        auto stoer_wagner = g::minimum_cut_stoer_wagner(r);
+        CHECK(stoer_wagner.value == expected);
+        check_cut(r, stoer_wagner);
+        auto karger_stein = g::minimum_cut_karger_stein(r, 20, 3, 42);
+        CHECK(karger_stein.value == expected);
+        check_cut(r, karger_stein);
+        // the result doesn't depend on the number of threads
+        CHECK(g::minimum_cut_karger_stein(r, 20, 1, 42).vertices == karger_stein.vertices);
+
+        // a disconnected graph
+        TestType d(4, 4, false);
+        d.set_edges(std::vector<edge_t>{{0, 1, 5}, {2, 3, 5}});
+        CHECK(g::minimum_cut_stoer_wagner(d).value == 0);
+        CHECK(g::minimum_cut_karger_stein(d).value == 0);
+
+        TestType directed(4, 4, true);
+        CHECK_THROWS_AS(g::minimum_cut_stoer_wagner(directed), g::error);
+        TestType single(1, 1, false);
+        CHECK_THROWS_AS(g::minimum_cut_karger_stein(single), g::error);
+    }
 }
 
-TEMPLATE_TEST_CASE("Impl - Bridges", "[impl-algos]", DenseGraphImpl, SparseGraphImpl) {
+TEMPLATE_TEST_CASE("Impl - Bridges", "[impl-algos]", DenseGraphImpl, SparseGraphImpl, CSRGraphImpl, BitDenseGraphImpl) {
     int n_vertices = 13;
     std::vector<edge_t> edges = {
         {0, 1}, {0, 2}, {1, 2}, {1, 4},  {2, 3},   {3, 7},  {4, 5},
@@ -322,7 +1439,7 @@ TEMPLATE_TEST_CASE("Impl - Bridges", "[impl-algos]", DenseGraphImpl, SparseGraph
     CHECK(expected_bridges == result);
 }
 
-TEMPLATE_TEST_CASE("Impl - Articulations Points", "[impl-algos]", DenseGraphImpl, SparseGraphImpl) {
+TEMPLATE_TEST_CASE("Impl - Articulations Points", "[impl-algos]", DenseGraphImpl, SparseGraphImpl, CSRGraphImpl, BitDenseGraphImpl) {
     int n_vertices = 14;
     std::vector<edge_t> edges = {
         {0, 1},  {0, 2}, {1, 2}, {2, 3}, {2, 4},  {3, 4},   {4, 5},  {4, 6},   {4, 7},   {4, 9},
@@ -349,7 +1466,9 @@ TEMPLATE_TEST_CASE(
     "Impl - Strongly Connected Components",
     "[impl-algos]",
     DenseGraphImpl,
-    SparseGraphImpl
+    SparseGraphImpl,
+    CSRGraphImpl,
+    BitDenseGraphImpl
 ) {
     std::vector<std::tuple<int, std::vector<edge_t>, std::vector<std::set<vertex_t>>>> graph_defs{
         {
@@ -415,3 +1534,58 @@ TEMPLATE_TEST_CASE(
         }
     }
 }
+
+TEMPLATE_TEST_CASE("Impl - Delta-stepping", "[impl-algos]", DenseGraphImpl, SparseGraphImpl, CSRGraphImpl) {
+    // large enough for the vertices to be shared between several threads
+    constexpr unsigned n = 700;
+    // with an unreachable vertex
+    auto edges = make_test_edges(n, 3, 5);
+
+    for (auto directed : {true, false}) {
+        TestType g(n, n, directed);
+        g.set_edges(edges);
+        for (vertex_t start : {0u, 42u}) {
+            auto expected = g::all_shortest_paths(g, start);
+            for (weight_t delta : {0, 1, 10, 1000}) {
+                for (unsigned n_threads : {1u, 4u}) {
+                    CAPTURE(directed, start, delta, n_threads);
+                    auto paths = g::all_shortest_paths_delta_stepping(g, start, delta, n_threads);
+                    CHECK(paths._distances == expected._distances);
+                    // the predecessors are the lowest ones on a shortest path
+                    for (vertex_t v = 0; v < n; ++v) {
+                        if (v == start || !paths.is_reachable(v)) {
+                            CHECK(paths._predecessors[v] == g::NO_PREDECESSOR);
+                            continue;
+                        }
+                        auto p = paths._predecessors[v];
+                        CHECK(paths._distances[p] + g.weight(p, v) == paths._distances[v]);
+                        for (vertex_t u = 0; u < p; ++u) {
+                            if (g.has_edge(u, v) && paths.is_reachable(u)) {
+                                CHECK(paths._distances[u] + g.weight(u, v) > paths._distances[v]);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Impl - Delta-stepping with a small delta", "[impl-algos]") {
+    // the distances span far more buckets than a thread can hold: the farther vertices overflow
+    constexpr unsigned n = 300;
+    g::SparseGraphImpl<double> g(n, n, true);
+    auto edges = make_test_edges<g::edge_t<double>>(n);
+    for (auto& edge : edges) {
+        edge.weight = edge.weight > 7 ? edge.weight * 2e4 : edge.weight - 0.5;
+    }
+    g.set_edges(edges);
+    auto expected = g::all_shortest_paths(g, 0);
+    for (double delta : {1e-3, 1.0}) {
+        for (unsigned n_threads : {1u, 4u}) {
+            CAPTURE(delta, n_threads);
+            auto paths = g::all_shortest_paths_delta_stepping(g, 0, delta, n_threads);
+            CHECK(paths._distances == expected._distances);
+        }
+    }
+}
@@ -1,5 +1,7 @@
 #include <grafology/disjoint_set.h>
 #include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <thread>
 
 namespace g = grafology;
 
@@ -29,3 +31,120 @@ TEST_CASE("Test DisjointSet", "[disjointset]")
     CHECK(ds.find(10) == ds.find(13));
     CHECK(ds.find(11) == ds.find(12));
 }
+
+TEST_CASE("Test DisjointSet sizes", "[disjointset]")
+{
+    constexpr size_t n_vertices = 15;
+    const std::vector <g::edge_t<int>> edges = {
+        {0, 1}, {0, 2}, {1, 2}, {1, 4}, {1, 3},
+        {4, 5}, {3,5}, {4, 6}, {6, 7}, {7, 8},
+        {14, 13}, {13, 11}, {11, 12}, {11, 10,}, {12, 10},
+    };
+
+    g::DisjointSet ds(n_vertices);
+    CHECK(ds.count() == n_vertices);
+    CHECK(ds.size_of(3) == 1);
+
+    CHECK(ds.merge_all(edges) == 12);
+    CHECK(ds.count() == 3);
+    CHECK(ds.size_of(0) == 9);
+    CHECK(ds.size_of(8) == 9);
+    CHECK(ds.size_of(9) == 1);
+    CHECK(ds.size_of(ds.find(12)) == 5);
+
+    // the edges are already merged
+    CHECK(ds.merge_all(edges) == 0);
+    CHECK(!ds.merge(5, 2));
+    CHECK(ds.merge(9, 10));
+    CHECK(ds.count() == 2);
+    CHECK(ds.size_of(14) == 6);
+}
+
+TEST_CASE("Test DisjointSet long chains", "[disjointset]")
+{
+    // without union by size, these merges make a chain 0 -> 1 -> ... -> n - 1
+    constexpr g::vertex_t n_vertices = 1'000'000;
+    g::DisjointSet ds(n_vertices);
+    g::vertex_t n_merges = 0;
+    for (g::vertex_t v = 1; v < n_vertices; ++v) {
+        n_merges += ds.merge(v - 1, v);
+    }
+    CHECK(n_merges == n_vertices - 1);
+    CHECK(ds.count() == 1);
+    CHECK(ds.size_of(0) == n_vertices);
+    CHECK(ds.find(0) == ds.find(n_vertices - 1));
+}
+
+TEST_CASE("Test ConcurrentDisjointSet", "[disjointset]")
+{
+    constexpr size_t n_vertices = 15;
+    const std::vector <g::edge_t<int>> edges = {
+        {0, 1}, {0, 2}, {1, 2}, {1, 4}, {1, 3},
+        {4, 5}, {3,5}, {4, 6}, {6, 7}, {7, 8},
+        {14, 13}, {13, 11}, {11, 12}, {11, 10,}, {12, 10},
+    };
+
+    g::ConcurrentDisjointSet ds(n_vertices);
+    for (const auto& edge : edges) {
+        ds.merge(edge.start, edge.end);
+    }
+
+    int n_disjoint_sets = 0;
+    for (const auto& root : ds.roots()) {
+        ++n_disjoint_sets;
+    }
+    REQUIRE(n_disjoint_sets == 3);
+    CHECK(ds.count() == 3);
+
+    CHECK(ds.find(0) == ds.find(5));
+    CHECK(ds.same_set(2, 6));
+    CHECK(ds.find(9) == 9);
+    CHECK(ds.same_set(10, 13));
+    CHECK(!ds.same_set(0, 13));
+    CHECK(!ds.merge(11, 12));
+}
+
+TEST_CASE("Test ConcurrentDisjointSet with threads", "[disjointset]")
+{
+    // random edges between the vertices with the same residue modulo 5, so there are 5 large sets
+    constexpr g::vertex_t n_vertices = 20'000;
+    std::vector<g::edge_t<int>> edges;
+    for (g::vertex_t i = 0; i < 3 * n_vertices; ++i) {
+        g::vertex_t u = (i * 7919u + 13) % n_vertices;
+        g::vertex_t v = (u + 5 * ((i * 104729u) % (n_vertices / 5))) % n_vertices;
+        edges.push_back({u, v});
+    }
+    g::DisjointSet expected(n_vertices);
+    auto n_expected_merges = expected.merge_all(edges);
+
+    g::ConcurrentDisjointSet ds(n_vertices);
+    CHECK(ds.merge_all(edges, 4) == n_expected_merges);
+    CHECK(ds.count() == expected.count());
+    for (g::vertex_t v = 1; v < n_vertices; ++v) {
+        CHECK(ds.same_set(v, v - 1) == (expected.find(v) == expected.find(v - 1)));
+    }
+
+    // merges and queries from several threads at the same time
+    g::ConcurrentDisjointSet shared(n_vertices);
+    std::atomic<bool> is_consistent = true;
+    {
+        std::vector<std::jthread> threads;
+        for (unsigned t = 0; t < 4; ++t) {
+            threads.emplace_back([&, t] {
+                for (std::size_t i = t; i < edges.size(); i += 4) {
+                    shared.merge(edges[i].start, edges[i].end);
+                    // a merged edge stays merged
+                    if (!shared.same_set(edges[i].start, edges[i].end)) {
+                        is_consistent = false;
+                    }
+                    shared.find(edges[(i * 31) % edges.size()].end);
+                }
+            });
+        }
+    }
+    CHECK(is_consistent);
+    CHECK(shared.count() == expected.count());
+    for (g::vertex_t v = 0; v < n_vertices; ++v) {
+        CHECK(shared.same_set(v, expected.find(v)));
+    }
+}
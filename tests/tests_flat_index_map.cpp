@@ -53,3 +53,22 @@ TEST_CASE("Test FlatIndexMap", "[flatindexmap]")
 }
 
 
+
+TEST_CASE("Test FlatIndexMap batch insertion", "[flatindexmap]")
+{
+    FlatIndexMap map;
+    map.set(3, 3);
+    map.set(10, 10);
+    map.set(20, 20);
+
+    // the last weight wins and a zero weight removes the entry
+    std::vector<FlatIndexMap::MapEntry> entries = {{45, 45}, {10, 1}, {2, 2}, {10, 11}, {20, 0}, {7, 0}};
+    std::vector<FlatIndexMap::MapEntry> expected = {{2, 2}, {3, 3}, {10, 11}, {45, 45}};
+    map.merge(entries.begin(), entries.end());
+
+    REQUIRE(map.size() == expected.size());
+    for (const auto& [stored, expected] : std::views::zip(map, expected)) {
+        REQUIRE(stored.vertex == expected.vertex);
+        REQUIRE(stored.weight == expected.weight);
+    }
+}
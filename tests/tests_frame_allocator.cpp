@@ -0,0 +1,85 @@
+#include <grafology/internal/frame_allocator.h>
+#include <grafology/utilities.h>
+#include <catch2/catch_test_macros.hpp>
+#include <array>
+#include <type_traits>
+#include <vector>
+
+namespace gi = grafology::internal;
+
+namespace {
+    generator<int> count(int n) {
+        for (int i = 0; i < n; ++i) {
+            co_yield i;
+        }
+    }
+}  // namespace
+
+TEST_CASE("Test FramePool", "[frame-allocator]")
+{
+    CHECK(gi::FramePool::get_size_class(1) == 0);
+    CHECK(gi::FramePool::get_size_class(64) == 0);
+    CHECK(gi::FramePool::get_size_class(65) == 1);
+    CHECK(gi::FramePool::get_size_class(8192) == 7);
+    CHECK(gi::FramePool::get_size_class(8193) == gi::FramePool::N_SIZE_CLASSES);
+
+    // a released block is recycled for the next allocation of the same size class
+    auto n_free_blocks = gi::FramePool::n_free_blocks(2);
+    void* p1 = gi::FramePool::allocate(200);
+    gi::FramePool::deallocate(p1, 200);
+    CHECK(gi::FramePool::n_free_blocks(2) == n_free_blocks + 1);
+    void* p2 = gi::FramePool::allocate(180);
+    CHECK(p1 == p2);
+    CHECK(gi::FramePool::n_free_blocks(2) == n_free_blocks);
+    gi::FramePool::deallocate(p2, 180);
+
+    // the number of cached blocks is bounded
+    std::vector<void*> blocks;
+    for (unsigned i = 0; i < 2 * gi::FramePool::MAX_FREE_BLOCKS; ++i) {
+        blocks.push_back(gi::FramePool::allocate(100));
+    }
+    for (auto block : blocks) {
+        gi::FramePool::deallocate(block, 100);
+    }
+    CHECK(gi::FramePool::n_free_blocks(1) == gi::FramePool::MAX_FREE_BLOCKS);
+
+    // large blocks are not cached
+    void* large = gi::FramePool::allocate(100'000);
+    gi::FramePool::deallocate(large, 100'000);
+}
+
+TEST_CASE("Test generators frame allocator", "[frame-allocator]")
+{
+    int total = 0;
+    for (int i = 0; i < 100; ++i) {
+        for (auto v : count(10)) {
+            total += v;
+        }
+    }
+    CHECK(total == 4500);
+
+    // the frames go through the pool of the current thread, unless the pool is disabled (POOLED_GENERATORS=OFF)
+    constexpr bool is_pooled = !std::is_void_v<GRAFOLOGY_GENERATOR_ALLOCATOR>;
+    auto n_free_blocks = [] {
+        std::array<unsigned, gi::FramePool::N_SIZE_CLASSES> counts;
+        for (std::size_t size_class = 0; size_class < counts.size(); ++size_class) {
+            counts[size_class] = gi::FramePool::n_free_blocks(size_class);
+        }
+        return counts;
+    };
+    auto before = n_free_blocks();
+    {
+        // the frames of the generators above have been released, so one of them is reused
+        auto g = count(10);
+        auto during = n_free_blocks();
+        std::size_t n_reused = 0;
+        for (std::size_t size_class = 0; size_class < before.size(); ++size_class) {
+            CAPTURE(size_class);
+            CHECK(during[size_class] <= before[size_class]);
+            n_reused += before[size_class] - during[size_class];
+        }
+        CHECK(n_reused == (is_pooled ? 1 : 0));
+    }
+    // the frame has been returned to the pool
+    CHECK(n_free_blocks() == before);
+}
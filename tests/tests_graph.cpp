@@ -11,10 +11,12 @@ using DirectedDenseGraph = g::DirectedDenseGraph<TestVertex, weight_t>;
 using DirectedSparseGraph = g::DirectedSparseGraph<TestVertex, weight_t>;
 using UndirectedDenseGraph = g::UndirectedDenseGraph<TestVertex, weight_t>;
 using UndirectedSparseGraph = g::UndirectedSparseGraph<TestVertex, weight_t>;
+using DirectedCSRGraph = g::DirectedCSRGraph<TestVertex, weight_t>;
+using UndirectedCSRGraph = g::UndirectedCSRGraph<TestVertex, weight_t>;
 
 TEMPLATE_TEST_CASE("Graphs", "[graphs]", 
-    DirectedDenseGraph , DirectedSparseGraph,
-    UndirectedDenseGraph , UndirectedSparseGraph) {
+    DirectedDenseGraph , DirectedSparseGraph, DirectedCSRGraph,
+    UndirectedDenseGraph , UndirectedSparseGraph, UndirectedCSRGraph) {
 
     using Edge = TestType::Edge;
 
@@ -21,6 +21,11 @@ TEST_CASE("Test R3Mat", "[generators]") {
                 auto gs = g::generate_r3mat_dense_graph<weight_t>(size, size, directed, 0);
                 REQUIRE(gs.size() == size);
             }
+            {
+                CAPTURE(size, directed, "csr");
+                auto gs = g::generate_r3mat_csr_graph<weight_t>(size, size, directed, 0);
+                REQUIRE(gs.size() == size);
+            }
         }
     }
 }
@@ -1,6 +1,8 @@
 #include <catch2/catch_template_test_macros.hpp>
 #include <grafology/dense_graph_impl.h>
 #include <grafology/sparse_graph_impl.h>
+#include <grafology/csr_graph_impl.h>
+#include <grafology/bit_dense_graph_impl.h>
 #include <ranges>
 #include <set>
 
@@ -10,9 +12,22 @@ using edge_t = g::edge_t<weight_t>;
 using vertex_t = g::vertex_t;
 using DenseGraphImpl = g::DenseGraphImpl<weight_t>;
 using SparseGraphImpl = g::SparseGraphImpl<weight_t>;
+using CSRGraphImpl = g::CSRGraphImpl<weight_t>;
+using BitDenseGraphImpl = g::BitDenseGraphImpl<weight_t>;
+
+// a sparse graph which maintains the index of the incoming edges
+struct IndexedSparseGraphImpl: SparseGraphImpl {
+    IndexedSparseGraphImpl(unsigned n_max_vertices, unsigned n_vertices, bool is_directed)
+    : SparseGraphImpl(n_max_vertices, n_vertices, is_directed, true) {}
+};
+
+static_assert(g::NeighborVisitor<DenseGraphImpl>);
+static_assert(g::NeighborVisitor<SparseGraphImpl>);
+static_assert(g::NeighborVisitor<CSRGraphImpl>);
+static_assert(g::NeighborVisitor<BitDenseGraphImpl>);
 
 TEMPLATE_TEST_CASE("Graph implementations", "[graph-impl]", 
-    DenseGraphImpl , SparseGraphImpl)
+    DenseGraphImpl , SparseGraphImpl, IndexedSparseGraphImpl, CSRGraphImpl)
 {
     constexpr unsigned max_vertices = 11;
     constexpr unsigned n_vertices = 7;
@@ -129,6 +144,29 @@ TEMPLATE_TEST_CASE("Graph implementations", "[graph-impl]",
                 CAPTURE(neighbors[i].size(), n_neighbors);
                 CHECK(neighbors[i].size() == n_neighbors);
             }
+            {
+                unsigned n_neighbors = 0;
+                g::for_each_neighbor(g, i, [&](const edge_t& neighbor) {
+                    CAPTURE(neighbor.start, neighbor.end, neighbor.weight);
+                    CHECK(neighbors[i].contains(neighbor.end));
+                    CHECK(neighbor.start + neighbor.end == neighbor.weight);
+                    ++n_neighbors;
+                });
+                CAPTURE(neighbors[i].size(), n_neighbors);
+                CHECK(neighbors[i].size() == n_neighbors);
+            }
+            {
+                unsigned n_in_neighbors = 0;
+                g::for_each_in_neighbor(g, i, [&](const edge_t& in_neighbor) {
+                    CAPTURE(in_neighbor.start, in_neighbor.end, in_neighbor.weight);
+                    CHECK(in_neighbors[i].contains(in_neighbor.start));
+                    CHECK(in_neighbor.end == i);
+                    CHECK(in_neighbor.start + in_neighbor.end == in_neighbor.weight);
+                    ++n_in_neighbors;
+                });
+                CAPTURE(in_neighbors[i].size(), n_in_neighbors);
+                CHECK(in_neighbors[i].size() == n_in_neighbors);
+            }
             {
                 unsigned n_neighbors = 0;
                 for (const auto& neighbor: g.get_raw_neighbors(i)) {
@@ -176,3 +214,189 @@ TEMPLATE_TEST_CASE("Graph implementations", "[graph-impl]",
     }
 }
 
+
+TEST_CASE("CSR graph implementation", "[graph-impl]")
+{
+    constexpr unsigned n_vertices = 6;
+    const std::vector<edge_t> edges {
+        {0, 1, 1}, {0, 2, 2}, {2, 3, 5}, {2, 4, 6}, {3, 1, 4}, {5, 1, 6}, {4, 4, 8},
+    };
+
+    for (bool is_directed: {true, false})
+    {
+        CAPTURE(is_directed);
+        // batch loading and edge by edge loading must give the same graph
+        CSRGraphImpl batch(n_vertices, n_vertices, is_directed);
+        batch.set_edges(edges);
+        CSRGraphImpl single(n_vertices, n_vertices, is_directed);
+        for (const auto& edge: std::views::reverse(edges)) {
+            single.set_edge(edge);
+        }
+        CHECK(batch == single);
+        CHECK(batch.n_edges() == (is_directed ? edges.size() : 2 * edges.size() - 1));
+
+        // duplicates: the last one wins, a zero weight removes the edge
+        batch.set_edges(std::vector<edge_t>{{0, 1, 3}, {0, 1, 7}, {2, 3, 0}, {1, 5, 9}});
+        CHECK(batch.weight(0, 1) == 7);
+        CHECK_FALSE(batch.has_edge(2, 3));
+        CHECK(batch.weight(1, 5) == 9);
+        CHECK(batch.weight(5, 1) == (is_directed ? 6 : 9));
+        single.set_edge(0, 1, 7);
+        single.set_edge(2, 3, 0);
+        single.set_edge(1, 5, 9);
+        CHECK(batch == single);
+
+        // a conflicting antiparallel pair in a batch: the last one wins, in both directions if undirected
+        batch.set_edges(std::vector<edge_t>{{3, 4, 5}, {4, 3, 3}});
+        CHECK(batch.weight(4, 3) == 3);
+        CHECK(batch.weight(3, 4) == (is_directed ? 5 : 3));
+        single.set_edge(3, 4, 5);
+        single.set_edge(4, 3, 3);
+        CHECK(batch == single);
+
+        // without the reverse CSR, the in-neighbors must be the same
+        CSRGraphImpl no_in_edges(n_vertices, n_vertices, is_directed, false);
+        no_in_edges.set_edges(edges);
+        CHECK_FALSE(no_in_edges.has_in_edges());
+        CSRGraphImpl in_edges(n_vertices, n_vertices, is_directed);
+        in_edges.set_edges(edges);
+        CHECK(in_edges.has_in_edges() == is_directed);
+        for (vertex_t i = 0; i < n_vertices; ++i) {
+            CAPTURE(i);
+            CHECK(no_in_edges.in_degree(i) == in_edges.in_degree(i));
+            std::set<edge_t> expected;
+            for (const auto& edge: in_edges.get_in_neighbors(i)) {
+                expected.insert(edge);
+            }
+            std::set<edge_t> result;
+            for (const auto& edge: no_in_edges.get_in_neighbors(i)) {
+                result.insert(edge);
+            }
+            CHECK(result == expected);
+        }
+        auto inverted = in_edges.invert();
+        auto inverted_no_in_edges = no_in_edges.invert();
+        std::set<edge_t> expected;
+        for (const auto& edge: inverted.get_all_edges()) {
+            expected.insert(edge);
+        }
+        std::set<edge_t> result;
+        for (const auto& edge: inverted_no_in_edges.get_all_edges()) {
+            result.insert(edge);
+        }
+        CHECK(result == expected);
+    }
+}
+
+TEST_CASE("Sparse graph batch loading", "[graph-impl]")
+{
+    constexpr unsigned n_vertices = 6;
+    const std::vector<edge_t> edges {
+        {0, 1, 1}, {0, 2, 2}, {2, 3, 5}, {0, 1, 7}, {2, 4, 6}, {3, 1, 4}, {5, 1, 6}, {4, 4, 8}, {2, 4, 0},
+    };
+
+    for (bool is_directed: {true, false})
+    {
+        CAPTURE(is_directed);
+        SparseGraphImpl single(n_vertices, n_vertices, is_directed);
+        single.set_edge(3, 1, 2);
+        single.set_edge(1, 5, 3);
+        SparseGraphImpl batch(single);
+        for (const auto& edge: edges) {
+            single.set_edge(edge);
+        }
+        batch.set_edges(edges);
+        CHECK(batch == single);
+        CHECK(batch.weight(0, 1) == 7);
+        CHECK(batch.weight(3, 1) == 4);
+        CHECK_FALSE(batch.has_edge(2, 4));
+    }
+}
+
+TEST_CASE("Sparse graph incoming edges index", "[graph-impl]")
+{
+    constexpr unsigned n_vertices = 6;
+    const std::vector<edge_t> edges {
+        {0, 1, 1}, {0, 2, 2}, {2, 3, 5}, {2, 4, 6}, {3, 1, 4}, {5, 1, 6}, {4, 4, 8},
+    };
+
+    SparseGraphImpl g(n_vertices, n_vertices, true);
+    SparseGraphImpl indexed(n_vertices, n_vertices, true, true);
+    CHECK_FALSE(g.has_in_edges());
+    CHECK(indexed.has_in_edges());
+    CHECK(g.in_edges_memory_usage() == 0);
+    g.set_edges(edges);
+    indexed.set_edges(edges);
+    CHECK(indexed.in_edges_memory_usage() > 0);
+    // the index must be kept consistent by set_edge
+    g.set_edge(3, 1, 0);
+    indexed.set_edge(3, 1, 0);
+    g.set_edge(1, 5, 3);
+    indexed.set_edge(1, 5, 3);
+
+    for (vertex_t i = 0; i < n_vertices; ++i) {
+        CAPTURE(i);
+        CHECK(g.in_degree(i) == indexed.in_degree(i));
+        std::set<edge_t> expected;
+        for (const auto& edge: g.get_in_neighbors(i)) {
+            expected.insert(edge);
+        }
+        std::set<edge_t> result;
+        for (const auto& edge: indexed.get_in_neighbors(i)) {
+            result.insert(edge);
+        }
+        CHECK(result == expected);
+    }
+}
+
+TEST_CASE("Bit dense graph implementation", "[graph-impl]")
+{
+    // more than 64 vertices so that the rows use several words
+    constexpr unsigned max_vertices = 150;
+    constexpr unsigned n_vertices = 140;
+    std::vector<edge_t> edges;
+    for (vertex_t i = 0; i < n_vertices; ++i) {
+        for (vertex_t j = (i * 7) % 5; j < n_vertices; j += 3 + i % 11) {
+            edges.push_back({i, j, 1});
+        }
+    }
+
+    for (bool is_directed: {true, false})
+    {
+        for (bool with_in_edges: {true, false})
+        {
+            CAPTURE(is_directed, with_in_edges);
+            DenseGraphImpl expected(max_vertices, n_vertices, is_directed);
+            expected.set_edges(edges);
+            BitDenseGraphImpl g(max_vertices, n_vertices, is_directed, with_in_edges);
+            g.set_edges(edges);
+            // removal
+            expected.set_edge(3, 6, 0);
+            g.set_edge(3, 6, 0);
+            CHECK_FALSE(g.has_edge(3, 6));
+
+            auto inverted = g.invert();
+            auto expected_inverted = expected.invert();
+            for (vertex_t i = 0; i < n_vertices; ++i) {
+                CAPTURE(i);
+                CHECK(g.degree(i) == expected.degree(i));
+                CHECK(g.in_degree(i) == expected.in_degree(i));
+                auto neighbors = g.get_raw_neighbors(i) | std::ranges::to<std::vector>();
+                CHECK(neighbors == (expected.get_raw_neighbors(i) | std::ranges::to<std::vector>()));
+                auto in_neighbors = g.get_raw_in_neighbors(i) | std::ranges::to<std::vector>();
+                CHECK(in_neighbors == (expected.get_raw_in_neighbors(i) | std::ranges::to<std::vector>()));
+                auto inverted_neighbors = inverted.get_raw_neighbors(i) | std::ranges::to<std::vector>();
+                CHECK(inverted_neighbors == (expected_inverted.get_raw_neighbors(i) | std::ranges::to<std::vector>()));
+            }
+            std::vector<edge_t> all_edges;
+            for (const auto& edge: g.get_all_edges()) {
+                all_edges.push_back(edge);
+            }
+            std::vector<edge_t> expected_all_edges;
+            for (const auto& edge: expected.get_all_edges()) {
+                expected_all_edges.push_back(edge);
+            }
+            CHECK(all_edges == expected_all_edges);
+        }
+    }
+}
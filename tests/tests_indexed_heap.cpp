@@ -0,0 +1,131 @@
+#include <grafology/indexed_heap.h>
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <random>
+
+namespace g = grafology;
+
+TEST_CASE("Test IndexedDAryHeap", "[indexedheap]")
+{
+    g::IndexedDAryHeap<int> heap(10);
+    REQUIRE(heap.empty());
+
+    heap.push(3, 30);
+    heap.push(5, 10);
+    heap.push(7, 20);
+    heap.push(1, 40);
+    REQUIRE(heap.size() == 4);
+    CHECK(heap.contains(3));
+    CHECK_FALSE(heap.contains(2));
+    CHECK(heap.top().vertex == 5);
+
+    // a vertex is stored only once
+    CHECK(heap.push_or_decrease(1, 5));
+    CHECK_FALSE(heap.push_or_decrease(7, 25));
+    CHECK(heap.size() == 4);
+    CHECK(heap.key(1) == 5);
+    CHECK(heap.key(7) == 20);
+
+    heap.decrease(3, 15);
+
+    std::vector<std::pair<g::vertex_t, int>> popped;
+    while (!heap.empty()) {
+        auto [key, vertex] = heap.pop();
+        CHECK_FALSE(heap.contains(vertex));
+        popped.push_back({vertex, key});
+    }
+    std::vector<std::pair<g::vertex_t, int>> expected = {{1, 5}, {5, 10}, {3, 15}, {7, 20}};
+    CHECK(popped == expected);
+
+    // a vertex can be pushed again once popped
+    heap.push(1, 1);
+    heap.push(2, 2);
+    heap.clear();
+    CHECK(heap.empty());
+    CHECK_FALSE(heap.contains(1));
+    CHECK_FALSE(heap.contains(2));
+}
+
+TEST_CASE("Test IndexedDAryHeap ordering", "[indexedheap]")
+{
+    constexpr unsigned n = 1000;
+    std::mt19937 rd(42);
+    std::uniform_int_distribution<int> keys(0, 100000);
+    g::IndexedDAryHeap<int, 3> heap(n);
+    std::vector<int> expected(n);
+    for (g::vertex_t v = 0; v < n; ++v) {
+        expected[v] = keys(rd);
+        heap.push(v, expected[v] + 100);
+    }
+    // every key is decreased after all the vertices are pushed
+    for (g::vertex_t v = 0; v < n; ++v) {
+        heap.decrease(v, expected[v]);
+    }
+    std::ranges::sort(expected);
+    for (auto key : expected) {
+        REQUIRE(heap.pop().key == key);
+    }
+    REQUIRE(heap.empty());
+}
+
+TEST_CASE("Test IndexedRadixHeap", "[indexedheap]")
+{
+    g::IndexedRadixHeap<int> heap(10);
+    heap.push(3, 30);
+    heap.push(5, 10);
+    heap.push(7, 20);
+    heap.push(1, 40);
+    CHECK(heap.push_or_decrease(1, 12));
+    CHECK_FALSE(heap.push_or_decrease(7, 25));
+    CHECK(heap.size() == 4);
+    CHECK(heap.key(1) == 12);
+
+    auto [key, vertex] = heap.pop();
+    CHECK(vertex == 5);
+    CHECK(key == 10);
+    // the keys can't be lower than the last popped key
+    heap.decrease(3, 11);
+    heap.push(2, 10);
+
+    std::vector<std::pair<g::vertex_t, int>> popped;
+    while (!heap.empty()) {
+        auto [key, vertex] = heap.pop();
+        CHECK_FALSE(heap.contains(vertex));
+        popped.push_back({vertex, key});
+    }
+    std::vector<std::pair<g::vertex_t, int>> expected = {{2, 10}, {3, 11}, {1, 12}, {7, 20}};
+    CHECK(popped == expected);
+}
+
+TEST_CASE("Test IndexedRadixHeap monotone ordering", "[indexedheap]")
+{
+    constexpr unsigned n = 1000;
+    std::mt19937 rd(42);
+    std::uniform_int_distribution<int> keys(0, 1000);
+    g::IndexedRadixHeap<long> heap(n);
+    g::IndexedDAryHeap<long> reference(n);
+    // a Dijkstra like sequence: the keys pushed after a pop are larger than the popped key
+    long last = 0;
+    for (g::vertex_t v = 0; v < n / 2; ++v) {
+        auto key = last + keys(rd);
+        heap.push(v, key);
+        reference.push(v, key);
+    }
+    for (g::vertex_t v = n / 2; v < n; ++v) {
+        auto [key, vertex] = heap.pop();
+        REQUIRE(key == reference.pop().key);
+        last = key;
+        auto new_key = last + keys(rd);
+        heap.push(v, new_key);
+        reference.push(v, new_key);
+        auto decreased = (v * 7) % n;
+        if (reference.contains(decreased) && reference.key(decreased) > last + 1) {
+            heap.decrease(decreased, last + 1);
+            reference.decrease(decreased, last + 1);
+        }
+    }
+    while (!reference.empty()) {
+        REQUIRE(heap.pop().key == reference.pop().key);
+    }
+    REQUIRE(heap.empty());
+}